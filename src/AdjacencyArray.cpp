@@ -0,0 +1,104 @@
+#include "AdjacencyArray.h"
+#include <algorithm>
+#include <unordered_map>
+
+
+void AdjacencyArray::build(const std::vector<std::shared_ptr<Node>>& nodes_list,
+                           const std::vector<std::unordered_set<std::shared_ptr<Edge>>>& edges_list) {
+    this->nodes = nodes_list;
+    this->offsets.clear();
+    this->neighbors.clear();
+    this->edges.clear();
+
+    this->offsets.reserve(this->nodes.size() + 1);
+    this->offsets.push_back(0);
+    for (uint32_t id = 0; id < this->nodes.size(); id++) {
+        const std::shared_ptr<Node>& node = this->nodes[id];
+        if (node) {
+            for (const std::shared_ptr<Edge>& edge : edges_list[id]) {
+                const std::shared_ptr<Node>& neighbor = (edge->getFirstNode() == node) ? edge->getSecondNode()
+                                                                                         : edge->getFirstNode();
+                this->neighbors.push_back(neighbor->getId());
+                this->edges.push_back(edge);
+            }
+        }
+        this->offsets.push_back((int)this->neighbors.size());
+    }
+
+    // every edge is in the rows of both of its nodes, and a self-loop only once in the row of its node
+    std::unordered_map<const Edge*, int> first_positions;
+    this->twins.resize(this->edges.size());
+    for (int i = 0; i < (int)this->edges.size(); i++) {
+        auto found = first_positions.find(this->edges[i].get());
+        if (found == first_positions.end()) {
+            first_positions.emplace(this->edges[i].get(), i);
+            this->twins[i] = i;
+            continue;
+        }
+        this->twins[i] = found->second;
+        this->twins[found->second] = i;
+    }
+
+    this->weights.resize(this->edges.size());
+    this->refreshWeights();
+}
+
+
+void AdjacencyArray::refreshWeights() {
+    this->max_weight = 0;
+    for (size_t i = 0; i < this->edges.size(); i++) {
+        // the length of an edge doesn't include the nodes, the weight is the distance between the centers
+        this->weights[i] = this->edges[i]->getLength() + 2 * NODE_RADIUS;
+        this->max_weight = std::max(this->max_weight, this->weights[i]);
+    }
+}
+
+
+uint32_t AdjacencyArray::size() const {
+    return (uint32_t)this->nodes.size();
+}
+
+
+const std::shared_ptr<Node>& AdjacencyArray::getNode(uint32_t id) const {
+    return this->nodes[id];
+}
+
+
+int AdjacencyArray::rowBegin(uint32_t id) const {
+    return this->offsets[id];
+}
+
+
+int AdjacencyArray::rowEnd(uint32_t id) const {
+    return this->offsets[id + 1];
+}
+
+
+uint32_t AdjacencyArray::getNeighbor(int position) const {
+    return this->neighbors[position];
+}
+
+
+int AdjacencyArray::getWeight(int position) const {
+    return this->weights[position];
+}
+
+
+int AdjacencyArray::getMaxWeight() const {
+    return this->max_weight;
+}
+
+
+int AdjacencyArray::getPositionsCount() const {
+    return (int)this->neighbors.size();
+}
+
+
+int AdjacencyArray::getTwin(int position) const {
+    return this->twins[position];
+}
+
+
+const std::shared_ptr<Edge>& AdjacencyArray::getEdge(int position) const {
+    return this->edges[position];
+}
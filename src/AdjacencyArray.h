@@ -0,0 +1,141 @@
+/**
+ * This code represents a compressed-sparse-row (CSR) snapshot of the graph's adjacency.
+ * Rows are indexed by the dense node ids of the graph, and the neighbors of node i are stored contiguously in
+ * neighbors[offsets[i]] .. neighbors[offsets[i+1]-1], together with the parallel weight and edge arrays.
+ * Ids that are currently free have an empty row and no node.
+ *
+ * The traversal algorithms iterate this structure instead of the hash-based neighbors list of the Graph,
+ * so that walking over the neighbors of a node streams through contiguous memory.
+ */
+
+#ifndef ALGOVIZ_ADJACENCYARRAY_H
+#define ALGOVIZ_ADJACENCYARRAY_H
+
+#include <memory>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+#include "Node.h"
+#include "Edge.h"
+
+
+class AdjacencyArray {
+    std::vector<std::shared_ptr<Node>> nodes; // node id -> node, nullptr for free ids
+    std::vector<int> offsets; // start of every node's row, offsets[i+1] is the end of row i
+    std::vector<uint32_t> neighbors; // id of the neighbor at every position of a row
+    std::vector<int> weights; // weight of the edge at every position of a row
+    std::vector<std::shared_ptr<Edge>> edges; // the edge object at every position of a row
+    std::vector<int> twins; // the position of the same edge in the row of the neighbor, for every position
+    int max_weight = 0; // the largest value in weights
+
+public:
+
+    /** Constructs an empty adjacency array.
+     *
+     */
+    AdjacencyArray() = default;
+
+
+    /** Rebuilds the adjacency array from the node and edge lists of a graph.
+     *
+     * @param nodes_list - the graph's nodes indexed by their ids
+     * @param edges_list - the graph's connected edges indexed by node ids
+     */
+    void build(const std::vector<std::shared_ptr<Node>>& nodes_list,
+               const std::vector<std::unordered_set<std::shared_ptr<Edge>>>& edges_list);
+
+
+    /** Reloads the weight of every edge from its current length.
+     *
+     * Edge lengths change when nodes are moved around, which doesn't change the topology of the graph,
+     * so there's no need to rebuild the whole array.
+     */
+    void refreshWeights();
+
+
+    /** Returns the number of rows in the adjacency array, which is one past the highest node id.
+     *
+     * @return The number of rows.
+     */
+    uint32_t size() const;
+
+
+    /** Returns the node with the given id.
+     *
+     * @param id - the id of the node
+     * @return A shared pointer to the node, or nullptr if the id is free.
+     */
+    const std::shared_ptr<Node>& getNode(uint32_t id) const;
+
+
+    /** Returns the position of the first neighbor of a node.
+     *
+     * @param id - the id of the node
+     * @return The position where the node's row starts.
+     */
+    int rowBegin(uint32_t id) const;
+
+
+    /** Returns the position after the last neighbor of a node.
+     *
+     * @param id - the id of the node
+     * @return The position where the node's row ends.
+     */
+    int rowEnd(uint32_t id) const;
+
+
+    /** Returns the id of the neighbor stored at a row position.
+     *
+     * @param position - a position inside some node's row
+     * @return The id of the neighbor.
+     */
+    uint32_t getNeighbor(int position) const;
+
+
+    /** Returns the weight of the edge stored at a row position, as used by Dijkstra's algorithm.
+     *
+     * @param position - a position inside some node's row
+     * @return The weight of the edge.
+     */
+    int getWeight(int position) const;
+
+
+    /** Returns the largest weight of an edge in the adjacency array.
+     *
+     * @return The largest edge weight, or 0 if there are no edges.
+     */
+    int getMaxWeight() const;
+
+
+    /** Returns the number of positions in all the rows, which counts every edge once for each end it's scanned from.
+     *
+     * @return The number of row positions, or 0 if there are no edges.
+     */
+    int getPositionsCount() const;
+
+
+    /** Returns the position of the same edge in the row of the neighbor stored at a row position.
+     *
+     * @param position - a position inside some node's row
+     * @return The position of the edge in the neighbor's row, which is the same position for a self-loop.
+     */
+    int getTwin(int position) const;
+
+
+    /** Returns the edge stored at a row position.
+     *
+     * @param position - a position inside some node's row
+     * @return A shared pointer to the edge.
+     */
+    const std::shared_ptr<Edge>& getEdge(int position) const;
+
+
+    /** Default destructor.
+     *
+     */
+    ~AdjacencyArray() = default;
+
+};
+
+
+#endif //ALGOVIZ_ADJACENCYARRAY_H
@@ -0,0 +1,58 @@
+#include "AlgorithmSteps.h"
+#include <utility>
+
+
+AlgorithmSteps AlgorithmSteps::promise_type::get_return_object() {
+    return AlgorithmSteps(std::coroutine_handle<promise_type>::from_promise(*this));
+}
+
+
+std::suspend_always AlgorithmSteps::promise_type::initial_suspend() noexcept {
+    return {};
+}
+
+
+std::suspend_always AlgorithmSteps::promise_type::final_suspend() noexcept {
+    return {};
+}
+
+
+std::suspend_always AlgorithmSteps::promise_type::yield_value(std::monostate) noexcept {
+    return {};
+}
+
+
+void AlgorithmSteps::promise_type::return_void() noexcept {}
+
+
+void AlgorithmSteps::promise_type::unhandled_exception() noexcept {
+    this->exception = std::current_exception();
+}
+
+
+AlgorithmSteps::AlgorithmSteps(std::coroutine_handle<promise_type> handle): handle(handle) {}
+
+
+AlgorithmSteps::AlgorithmSteps(AlgorithmSteps&& other) noexcept: handle(std::exchange(other.handle, nullptr)) {}
+
+
+AlgorithmSteps& AlgorithmSteps::operator=(AlgorithmSteps&& other) noexcept {
+    if (this != &other) {
+        if (this->handle) this->handle.destroy();
+        this->handle = std::exchange(other.handle, nullptr);
+    }
+    return *this;
+}
+
+
+bool AlgorithmSteps::next() {
+    if (!this->handle || this->handle.done()) return false;
+    this->handle.resume();
+    if (this->handle.promise().exception) std::rethrow_exception(this->handle.promise().exception);
+    return !this->handle.done();
+}
+
+
+AlgorithmSteps::~AlgorithmSteps() {
+    if (this->handle) this->handle.destroy();
+}
@@ -0,0 +1,63 @@
+/**
+ * This code represents a graph algorithm that runs one step at a time, written as a C++20 coroutine.
+ *
+ * The algorithm records its changes in an event stream and ends every step with `co_yield {};`, which suspends it
+ * until the caller asks for the next step. The caller can run as many steps as it wants whenever it wants on its own
+ * thread, pause between any two steps, or stop the algorithm by simply destroying it.
+ */
+
+#ifndef ALGOVIZ_ALGORITHMSTEPS_H
+#define ALGOVIZ_ALGORITHMSTEPS_H
+
+#include <coroutine>
+#include <exception>
+#include <variant>
+
+
+class AlgorithmSteps {
+public:
+
+    struct promise_type {
+        std::exception_ptr exception = nullptr;
+
+        AlgorithmSteps get_return_object();
+        std::suspend_always initial_suspend() noexcept;
+        std::suspend_always final_suspend() noexcept;
+        std::suspend_always yield_value(std::monostate) noexcept;
+        void return_void() noexcept;
+        void unhandled_exception() noexcept;
+    };
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    /** Constructs the steps of a started coroutine. Called by the promise.
+     *
+     * @param handle - the handle of the coroutine, suspended before its first step
+     */
+    explicit AlgorithmSteps(std::coroutine_handle<promise_type> handle);
+
+public:
+
+    AlgorithmSteps(const AlgorithmSteps&) = delete;
+    AlgorithmSteps& operator=(const AlgorithmSteps&) = delete;
+    AlgorithmSteps(AlgorithmSteps&& other) noexcept;
+    AlgorithmSteps& operator=(AlgorithmSteps&& other) noexcept;
+
+
+    /** Runs the algorithm until the end of its next step.
+     *
+     * @return True if a step ended, false if the algorithm is done.
+     */
+    bool next();
+
+
+    /** Destroys the coroutine, stopping the algorithm if it isn't done.
+     *
+     */
+    ~AlgorithmSteps();
+
+};
+
+
+#endif //ALGOVIZ_ALGORITHMSTEPS_H
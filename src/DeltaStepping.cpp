@@ -0,0 +1,159 @@
+#include "DeltaStepping.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <climits>
+#include <thread>
+
+
+DeltaStepping::DeltaStepping(const AdjacencyArray& adjacency, unsigned int threads_count, int delta):
+        adjacency(adjacency), delta(delta) {
+    if (threads_count == 0) threads_count = std::thread::hardware_concurrency();
+    this->threads_count = std::max(threads_count, 1u);
+    if (this->delta <= 0) {
+        // about one bucket of light edges per average neighborhood
+        // counted from the row positions rather than the offsets, which an unbuilt array doesn't have
+        uint32_t nodes_count = std::max(this->adjacency.size(), 1u);
+        int average_degree = std::max(this->adjacency.getPositionsCount() / (int)nodes_count, 1);
+        this->delta = std::max(this->adjacency.getMaxWeight() / average_degree, 1);
+    }
+}
+
+
+bool DeltaStepping::run(uint32_t source, std::stop_token stop_token) {
+    uint32_t nodes_count = this->adjacency.size();
+    this->tentative_weights = std::make_unique<std::atomic<int>[]>(nodes_count);
+    for (uint32_t id = 0; id < nodes_count; id++) this->tentative_weights[id].store(INT_MAX, std::memory_order_relaxed);
+    this->tentative_weights[source].store(0, std::memory_order_relaxed);
+    this->buckets.assign(1, {source});
+    this->round_stamps.assign(nodes_count, 0);
+    this->bucket_stamps.assign(nodes_count, 0);
+    this->removed_nodes.clear();
+    this->current_bucket = 0;
+    this->round = 0;
+    this->is_heavy_round = false;
+    this->is_done = false;
+
+    // small graphs don't have enough nodes per round to keep many workers busy
+    unsigned int workers_count = std::min<unsigned int>(this->threads_count,
+                                                        nodes_count / DELTA_STEPPING_CHUNK_SIZE + 1);
+    this->thread_buffers.assign(workers_count, {});
+    // every round runs as one group of workers, and the nodes they lowered are put into buckets between rounds
+    for (this->advanceRound(); !this->is_done; this->advanceRound()) {
+        if (stop_token.stop_requested()) return false;
+        TaskGroup group;
+        for (unsigned int i = 1; i < workers_count; i++) group.run([this, i]() { this->relaxEdges(i); });
+        this->relaxEdges(0);
+        group.wait();
+    }
+
+    this->weights.resize(nodes_count);
+    for (uint32_t id = 0; id < nodes_count; id++) {
+        this->weights[id] = this->tentative_weights[id].load(std::memory_order_relaxed);
+    }
+    this->findParents();
+    return true;
+}
+
+
+void DeltaStepping::relaxEdges(unsigned int thread_index) {
+    std::vector<uint32_t>& buffer = this->thread_buffers[thread_index];
+    size_t chunks_count = (this->round_nodes.size() + DELTA_STEPPING_CHUNK_SIZE - 1) / DELTA_STEPPING_CHUNK_SIZE;
+    for (size_t chunk = this->next_chunk++; chunk < chunks_count; chunk = this->next_chunk++) {
+        size_t chunk_end = std::min((chunk + 1) * DELTA_STEPPING_CHUNK_SIZE, this->round_nodes.size());
+        for (size_t i = chunk * DELTA_STEPPING_CHUNK_SIZE; i < chunk_end; i++) {
+            uint32_t current = this->round_nodes[i];
+            // another worker may lower it meanwhile, which puts it back in a bucket to be relaxed again
+            int current_weight = this->tentative_weights[current].load(std::memory_order_relaxed);
+            for (int j = this->adjacency.rowBegin(current); j < this->adjacency.rowEnd(current); j++) {
+                if ((this->adjacency.getWeight(j) > this->delta) != this->is_heavy_round) continue;
+                uint32_t neighbor = this->adjacency.getNeighbor(j);
+                int new_weight = current_weight + this->adjacency.getWeight(j);
+                int old_weight = this->tentative_weights[neighbor].load(std::memory_order_relaxed);
+                while (new_weight < old_weight) {
+                    if (this->tentative_weights[neighbor].compare_exchange_weak(old_weight, new_weight,
+                                                                                std::memory_order_relaxed)) {
+                        buffer.push_back(neighbor);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+void DeltaStepping::advanceRound() {
+    for (std::vector<uint32_t>& buffer : this->thread_buffers) {
+        for (uint32_t id : buffer) {
+            size_t bucket = this->tentative_weights[id].load(std::memory_order_relaxed) / this->delta;
+            if (bucket >= this->buckets.size()) this->buckets.resize(bucket + 1);
+            this->buckets[bucket].push_back(id);
+        }
+        buffer.clear();
+    }
+    if (this->is_heavy_round) {
+        this->is_heavy_round = false;
+        this->removed_nodes.clear();
+        this->current_bucket++;
+    }
+    this->next_chunk = 0;
+    this->round++;
+
+    while (this->current_bucket < this->buckets.size()) {
+        // a bucket may hold nodes that were lowered into an earlier bucket since, or the same node more than once
+        this->round_nodes.clear();
+        std::vector<uint32_t>& bucket = this->buckets[this->current_bucket];
+        for (uint32_t id : bucket) {
+            size_t id_bucket = this->tentative_weights[id].load(std::memory_order_relaxed) / this->delta;
+            if (id_bucket != this->current_bucket || this->round_stamps[id] == this->round) continue;
+            this->round_stamps[id] = this->round;
+            this->round_nodes.push_back(id);
+            if (this->bucket_stamps[id] != this->current_bucket + 1) {
+                this->bucket_stamps[id] = this->current_bucket + 1;
+                this->removed_nodes.push_back(id);
+            }
+        }
+        bucket.clear();
+        if (!this->round_nodes.empty()) return;
+
+        if (!this->removed_nodes.empty()) {
+            // the bucket stayed empty, so the weights of its nodes are final and their heavy edges can be relaxed
+            this->round_nodes.swap(this->removed_nodes);
+            this->is_heavy_round = true;
+            return;
+        }
+        this->current_bucket++;
+    }
+    this->is_done = true;
+}
+
+
+void DeltaStepping::findParents() {
+    this->parents.assign(this->adjacency.size(), INVALID_NODE_ID);
+    // every node picks its own parent from the final weights, so the nodes are split across the pool as they are
+    ThreadPool::shared().parallelFor(0, this->adjacency.size(), DELTA_STEPPING_CHUNK_SIZE,
+                                     [this](size_t begin, size_t end) {
+        for (uint32_t id = begin; id < end; id++) {
+            if (this->weights[id] == INT_MAX || this->weights[id] == 0) continue;
+            for (int j = this->adjacency.rowBegin(id); j < this->adjacency.rowEnd(id); j++) {
+                // the graph is undirected, so an edge weighs the same in the rows of both of its nodes
+                uint32_t neighbor = this->adjacency.getNeighbor(j);
+                if (this->weights[neighbor] != INT_MAX &&
+                    this->weights[neighbor] + this->adjacency.getWeight(j) == this->weights[id]) {
+                    this->parents[id] = neighbor;
+                    break;
+                }
+            }
+        }
+    });
+}
+
+
+const std::vector<int>& DeltaStepping::getWeights() const {
+    return this->weights;
+}
+
+
+const std::vector<uint32_t>& DeltaStepping::getParents() const {
+    return this->parents;
+}
@@ -0,0 +1,111 @@
+/**
+ * This code provides a headless single-source shortest paths search over an adjacency array (Meyer and Sanders'
+ * delta-stepping), which settles the nodes in parallel across a group of worker threads.
+ *
+ * Tentative weights are kept in buckets of width delta. The lowest nonempty bucket is emptied in rounds: every round
+ * relaxes the light edges (weight of at most delta) of all the nodes in the bucket at once, which can only refill
+ * the same bucket or later ones. Once the bucket stays empty, the heavy edges of every node removed from it are
+ * relaxed in one more round. The nodes of a round are cut into chunks that the workers take one at a time, every
+ * relaxation lowers the tentative weight with an atomic compare-and-swap, and every worker collects the nodes it
+ * lowered in its own buffer, which are put into buckets between rounds. The workers are tasks of the shared thread
+ * pool, see ThreadPool.
+ */
+
+#ifndef ALGOVIZ_DELTASTEPPING_H
+#define ALGOVIZ_DELTASTEPPING_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stop_token>
+#include <vector>
+#include "AdjacencyArray.h"
+
+#define DELTA_STEPPING_CHUNK_SIZE 256 // the number of nodes a worker takes at a time
+
+
+class DeltaStepping {
+    const AdjacencyArray& adjacency;
+    unsigned int threads_count;
+    int delta;
+    std::vector<int> weights; // weight of the shortest path to every node, indexed by node id, INT_MAX if unreached
+    std::vector<uint32_t> parents; // the node before every node on its shortest path, indexed by node id
+    std::unique_ptr<std::atomic<int>[]> tentative_weights; // indexed by node id, lowered while the search runs
+    std::vector<std::vector<uint32_t>> buckets; // bucket i holds nodes with tentative weights in [i*delta, (i+1)*delta)
+    std::vector<std::vector<uint32_t>> thread_buffers; // the nodes every worker lowered in the current round
+    std::vector<uint32_t> round_nodes; // the nodes whose edges are relaxed in the current round
+    std::vector<uint32_t> removed_nodes; // the nodes removed from the current bucket so far
+    std::vector<uint32_t> round_stamps; // the last round every node was added to round_nodes in, indexed by node id
+    std::vector<uint32_t> bucket_stamps; // one past the last bucket every node was removed from, indexed by node id
+    size_t current_bucket = 0;
+    uint32_t round = 0;
+    bool is_heavy_round = false;
+    std::atomic<size_t> next_chunk = 0; // the next chunk of round_nodes a worker should take
+    bool is_done = false;
+
+
+    /** Relaxes the light or heavy edges of the nodes in the chunks of round_nodes the calling worker takes.
+     *
+     * @param thread_index - the index of the calling worker
+     */
+    void relaxEdges(unsigned int thread_index);
+
+
+    /** Puts the nodes the workers lowered into buckets and picks the nodes of the next round. Called once all
+     * workers are done relaxing.
+     *
+     */
+    void advanceRound();
+
+
+    /** Picks the parent of every reached node from its final weight, once the search is done.
+     *
+     */
+    void findParents();
+
+public:
+
+    /** Constructs a delta-stepping engine over an adjacency array.
+     *
+     * @param adjacency - the adjacency array to search, which must outlive the engine
+     * @param threads_count - the number of workers, or 0 to use one per hardware thread
+     * @param delta - the width of the buckets, or 0 to pick it from the edge weights and the average degree
+     */
+    DeltaStepping(const AdjacencyArray& adjacency, unsigned int threads_count = 0, int delta = 0);
+
+
+    /** Runs the search from a source node, replacing the results of any previous run.
+     *
+     * The weights are the same as the ones Dijkstra's algorithm finds. Of all the neighbors a node can be reached
+     * from on a shortest path, the first one in its adjacency row is picked as its parent.
+     *
+     * @param source - the id of the node to start from
+     * @param stop_token - stops the search between two rounds when a stop is requested
+     * @return True if the search settled every node it could reach, false if it was stopped before.
+     */
+    bool run(uint32_t source, std::stop_token stop_token = {});
+
+
+    /** Returns the weight of the shortest path to every node from the source of the last run.
+     *
+     * @return The weights indexed by node id, INT_MAX for nodes that weren't reached.
+     */
+    const std::vector<int>& getWeights() const;
+
+
+    /** Returns the node before every node on its shortest path in the last run.
+     *
+     * @return The parent ids indexed by node id, INVALID_NODE_ID for the source and for nodes that weren't reached.
+     */
+    const std::vector<uint32_t>& getParents() const;
+
+
+    /** Default destructor.
+     *
+     */
+    ~DeltaStepping() = default;
+
+};
+
+
+#endif //ALGOVIZ_DELTASTEPPING_H
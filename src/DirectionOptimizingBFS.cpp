@@ -0,0 +1,111 @@
+#include "DirectionOptimizingBFS.h"
+#include <algorithm>
+#include <climits>
+
+
+DirectionOptimizingBFS::DirectionOptimizingBFS(const AdjacencyArray& adjacency): adjacency(adjacency) {}
+
+
+bool DirectionOptimizingBFS::run(uint32_t source, std::stop_token stop_token) {
+    uint32_t nodes_count = this->adjacency.size();
+    this->distances.assign(nodes_count, INT_MAX);
+    this->parents.assign(nodes_count, INVALID_NODE_ID);
+    this->queue_positions.assign(nodes_count, UINT32_MAX);
+    this->frontier_bitmap.assign((nodes_count + 63) / 64, 0);
+    this->frontier.assign(1, source);
+    this->frontier_offset = 0;
+    this->bottom_up_steps = 0;
+    this->distances[source] = 0;
+    this->queue_positions[source] = 0;
+
+    long long frontier_edges = this->degree(source);
+    long long unexplored_edges = this->adjacency.getPositionsCount() - frontier_edges;
+    for (int level = 0; !this->frontier.empty(); level++) {
+        if (stop_token.stop_requested()) return false;
+        // a top-down step checks every edge of the frontier, a bottom-up step at most every edge of the unvisited nodes
+        if (frontier_edges > unexplored_edges) {
+            frontier_edges = this->bottomUpStep(level);
+            this->bottom_up_steps++;
+        }
+        else frontier_edges = this->topDownStep(level);
+        unexplored_edges -= frontier_edges;
+
+        this->frontier_offset += (uint32_t)this->frontier.size();
+        std::swap(this->frontier, this->next_frontier);
+        for (size_t i = 0; i < this->frontier.size(); i++) {
+            this->queue_positions[this->frontier[i]] = this->frontier_offset + (uint32_t)i;
+        }
+    }
+    return true;
+}
+
+
+long long DirectionOptimizingBFS::topDownStep(int level) {
+    long long next_edges = 0;
+    this->next_frontier.clear();
+    for (uint32_t current : this->frontier) {
+        for (int i = this->adjacency.rowBegin(current); i < this->adjacency.rowEnd(current); i++) {
+            uint32_t neighbor = this->adjacency.getNeighbor(i);
+            if (this->distances[neighbor] != INT_MAX) continue;
+            this->distances[neighbor] = level + 1;
+            this->parents[neighbor] = current;
+            this->next_frontier.push_back(neighbor);
+            next_edges += this->degree(neighbor);
+        }
+    }
+    return next_edges;
+}
+
+
+long long DirectionOptimizingBFS::bottomUpStep(int level) {
+    long long next_edges = 0;
+    for (uint32_t id : this->frontier) this->frontier_bitmap[id / 64] |= (uint64_t)1 << (id % 64);
+    this->reached_nodes.clear();
+    for (uint32_t current = 0; current < this->adjacency.size(); current++) {
+        if (this->distances[current] != INT_MAX) continue;
+        // the queue position of the frontier node in the high bits, and the edge's index in its row in the low bits
+        uint64_t first_order = UINT64_MAX;
+        for (int i = this->adjacency.rowBegin(current); i < this->adjacency.rowEnd(current); i++) {
+            uint32_t neighbor = this->adjacency.getNeighbor(i);
+            if (!(this->frontier_bitmap[neighbor / 64] & ((uint64_t)1 << (neighbor % 64)))) continue;
+            int twin = this->adjacency.getTwin(i);
+            uint64_t order = ((uint64_t)this->queue_positions[neighbor] << 32) |
+                             (uint32_t)(twin - this->adjacency.rowBegin(neighbor));
+            first_order = std::min(first_order, order);
+        }
+        if (first_order == UINT64_MAX) continue;
+        this->distances[current] = level + 1;
+        this->parents[current] = this->frontier[(first_order >> 32) - this->frontier_offset];
+        this->reached_nodes.emplace_back(first_order, current);
+        next_edges += this->degree(current);
+    }
+    for (uint32_t id : this->frontier) this->frontier_bitmap[id / 64] = 0;
+
+    // a queue would hold the reached nodes in the order of the edges they were reached by
+    std::sort(this->reached_nodes.begin(), this->reached_nodes.end());
+    this->next_frontier.clear();
+    for (const std::pair<uint64_t, uint32_t>& reached : this->reached_nodes) {
+        this->next_frontier.push_back(reached.second);
+    }
+    return next_edges;
+}
+
+
+int DirectionOptimizingBFS::degree(uint32_t id) const {
+    return this->adjacency.rowEnd(id) - this->adjacency.rowBegin(id);
+}
+
+
+const std::vector<int>& DirectionOptimizingBFS::getDistances() const {
+    return this->distances;
+}
+
+
+const std::vector<uint32_t>& DirectionOptimizingBFS::getParents() const {
+    return this->parents;
+}
+
+
+int DirectionOptimizingBFS::getBottomUpSteps() const {
+    return this->bottom_up_steps;
+}
@@ -0,0 +1,112 @@
+/**
+ * This code provides a headless, level-synchronous breadth-first search over an adjacency array, which switches
+ * between top-down and bottom-up steps depending on the size of the frontier (Beamer's direction-optimizing BFS).
+ *
+ * A top-down step scans the edges of every frontier node, looking for unvisited neighbors. A bottom-up step scans
+ * the edges of every unvisited node, looking for neighbors in the frontier, whose membership is tested in a bitmap
+ * with one bit per node id. Once the frontier holds a large part of the graph, the unvisited nodes have fewer edges
+ * left than the frontier does, so the bottom-up step skips most of the edges the top-down step would check.
+ *
+ * A queue-based BFS reaches a node from the first frontier node in queue order that has it as a neighbor, and puts
+ * the nodes reached from the same frontier node in the order of that node's row. A bottom-up step keeps both: every
+ * unvisited node takes the edge to a frontier neighbor that a queue would scan first, and the next level is sorted
+ * by that order. So every node gets the same distance and parent as a queue-based BFS in either direction.
+ */
+
+#ifndef ALGOVIZ_DIRECTIONOPTIMIZINGBFS_H
+#define ALGOVIZ_DIRECTIONOPTIMIZINGBFS_H
+
+#include <cstdint>
+#include <stop_token>
+#include <utility>
+#include <vector>
+#include "AdjacencyArray.h"
+
+
+class DirectionOptimizingBFS {
+    const AdjacencyArray& adjacency;
+    std::vector<int> distances; // distance of every node from the source, indexed by node id, INT_MAX if unreached
+    std::vector<uint32_t> parents; // the node every node was reached from, indexed by node id
+    std::vector<uint32_t> queue_positions; // the position every reached node would have in a queue, by node id
+    std::vector<uint32_t> frontier; // ids of the nodes in the current level, in the order a queue would hold them
+    std::vector<uint32_t> next_frontier;
+    std::vector<uint64_t> frontier_bitmap; // bit i is set if node i is in the current level, used by bottom-up steps
+    std::vector<std::pair<uint64_t, uint32_t>> reached_nodes; // the nodes a bottom-up step reached, by edge order
+    uint32_t frontier_offset = 0; // the queue position of the first node of the frontier
+    int bottom_up_steps = 0; // the number of levels of the last run that ran bottom-up
+
+
+    /** Returns the number of edges of a node.
+     *
+     * @param id - the id of the node
+     * @return The degree of the node.
+     */
+    int degree(uint32_t id) const;
+
+
+    /** Reaches the next level from the nodes in frontier and stores it in next_frontier.
+     *
+     * @param level - the distance of the current level from the source
+     * @return The number of edges of the nodes in the next level.
+     */
+    long long topDownStep(int level);
+
+
+    /** Reaches the next level from the unvisited nodes, looking for their neighbors in frontier_bitmap, and stores
+     * it in next_frontier.
+     *
+     * @param level - the distance of the current level from the source
+     * @return The number of edges of the nodes in the next level.
+     */
+    long long bottomUpStep(int level);
+
+public:
+
+    /** Constructs a BFS engine over an adjacency array.
+     *
+     * @param adjacency - the adjacency array to search, which must outlive the engine
+     */
+    explicit DirectionOptimizingBFS(const AdjacencyArray& adjacency);
+
+
+    /** Runs the search from a source node, replacing the results of any previous run.
+     *
+     * Every level runs bottom-up when the unvisited nodes have fewer edges than the frontier, and top-down otherwise.
+     *
+     * @param source - the id of the node to start from
+     * @param stop_token - stops the search between two levels when a stop is requested
+     * @return True if the search reached every node it could, false if it was stopped before.
+     */
+    bool run(uint32_t source, std::stop_token stop_token = {});
+
+
+    /** Returns the distance of every node from the source of the last run.
+     *
+     * @return The distances indexed by node id, INT_MAX for nodes that weren't reached.
+     */
+    const std::vector<int>& getDistances() const;
+
+
+    /** Returns the node every node was reached from in the last run.
+     *
+     * @return The parent ids indexed by node id, INVALID_NODE_ID for the source and for nodes that weren't reached.
+     */
+    const std::vector<uint32_t>& getParents() const;
+
+
+    /** Returns the number of levels of the last run that ran bottom-up.
+     *
+     * @return The number of bottom-up steps.
+     */
+    int getBottomUpSteps() const;
+
+
+    /** Default destructor.
+     *
+     */
+    ~DirectionOptimizingBFS() = default;
+
+};
+
+
+#endif //ALGOVIZ_DIRECTIONOPTIMIZINGBFS_H
@@ -24,13 +24,16 @@
 #define DISCOVERED_EDGE_COLOR   (sf::Color::White)
 #define SELECTED_EDGE_COLOR     (sf::Color::Red)
 #define NEAREST_EDGE_COLOR      (sf::Color::Magenta)
+#define DISCOVERED_BACKWARD_EDGE_COLOR (sf::Color(255, 200, 120))
 #define NODE_RADIUS 30
+#define EDGE_WIDTH 3 // the width of an edge's rectangle
 
 enum EdgeState {
     EDGE_DISCOVERED,
     EDGE_UNDISCOVERED,
     EDGE_NEAREST,
-    EDGE_SELECTED
+    EDGE_SELECTED,
+    EDGE_DISCOVERED_BACKWARD // discovered by the search that grows from the target node
 };
 
 class Edge {
@@ -39,6 +42,8 @@ class Edge {
     const std::shared_ptr<Node> first_node;
     const std::shared_ptr<Node> second_node;
     float length;
+    EdgeState state = EDGE_UNDISCOVERED;
+    uint32_t run = 0; // the run of the nodes' table the state was set in, an older one reads as undiscovered
 
 public:
 
@@ -59,22 +64,29 @@ public:
     void render(sf::RenderTarget& target);
 
 
-    /** Sets the color of this edge.
+    /** Sets the state of this edge.
      *
-     * To be used based on the current state.
+     * Used while traversing the graph in BFS/DFS/DIJKSTRA.
      *
-     * @param color Set according to the current state.
+     * @param state The current state, as defined by the algorithm's progression.
      */
-    void setColor(const sf::Color& color);
+    void setState(EdgeState state);
 
 
-    /** Sets the state of this edge.
+    /** Returns the fill color an edge is drawn with in the given state.
      *
-     * Used while traversing the graph in BFS/DFS/DIJKSTRA.
+     * @param state The state of the edge.
+     * @return The fill color of the state.
+     */
+    static sf::Color getStateColor(EdgeState state);
+
+
+    /** Returns the current state of this edge.
      *
-     * @param state The current state, as defined by the algorithm's progression.
+     * @return An EdgeState enum value representing the current state of this edge, EDGE_UNDISCOVERED if it wasn't
+     * set since the nodes' table started its current run.
      */
-    void setState(EdgeState state);
+    EdgeState getState() const;
 
 
     /** Returns the length of this edge as an int.
@@ -0,0 +1,79 @@
+#include "EdgeBatch.h"
+#include <cmath>
+
+
+void EdgeBatch::add(const std::shared_ptr<Edge>& edge) {
+    uint32_t index = (uint32_t)this->slots.size();
+    this->slots.push_back({edge, EDGE_UNDISCOVERED});
+    this->slot_indices[edge.get()] = index;
+    this->quads.resize(4 * this->slots.size());
+    this->lines.resize(2 * this->slots.size());
+    this->fillGeometry(index);
+    this->fillColor(index);
+}
+
+
+void EdgeBatch::remove(const Edge* edge) {
+    auto found = this->slot_indices.find(edge);
+    if (found == this->slot_indices.end()) return;
+    uint32_t index = found->second;
+    uint32_t last_index = (uint32_t)this->slots.size() - 1;
+    this->slot_indices.erase(found);
+    if (index != last_index) {
+        this->slots[index] = std::move(this->slots[last_index]);
+        this->slot_indices[this->slots[index].edge.get()] = index;
+        for (int i = 0; i < 4; i++) this->quads[4 * index + i] = this->quads[4 * last_index + i];
+        for (int i = 0; i < 2; i++) this->lines[2 * index + i] = this->lines[2 * last_index + i];
+    }
+    this->slots.pop_back();
+    this->quads.resize(4 * this->slots.size());
+    this->lines.resize(2 * this->slots.size());
+}
+
+
+void EdgeBatch::fillGeometry(uint32_t index) {
+    const EdgeSlot& slot = this->slots[index];
+    // the edge's own rectangle is what hit tests and the edge weights go by, so it follows the drawn one
+    slot.edge->correctEdgeCoordinates();
+
+    sf::Vector2f first_center = slot.edge->getFirstNode()->getPosition() + sf::Vector2f(NODE_RADIUS, NODE_RADIUS);
+    sf::Vector2f second_center = slot.edge->getSecondNode()->getPosition() + sf::Vector2f(NODE_RADIUS, NODE_RADIUS);
+    sf::Vector2f offset = second_center - first_center;
+    float distance = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+    sf::Vector2f direction = (distance > 0) ? offset / distance : sf::Vector2f(0, 1);
+    sf::Vector2f side(direction.y * EDGE_WIDTH, -direction.x * EDGE_WIDTH);
+    // like the edge's rectangle, the quad spans the gap between the circles of the two nodes
+    sf::Vector2f begin = first_center + direction * (float)NODE_RADIUS;
+    sf::Vector2f end = second_center - direction * (float)NODE_RADIUS;
+
+    this->quads[4 * index].position = begin;
+    this->quads[4 * index + 1].position = begin + side;
+    this->quads[4 * index + 2].position = end + side;
+    this->quads[4 * index + 3].position = end;
+    this->lines[2 * index].position = begin + side / 2.f;
+    this->lines[2 * index + 1].position = end + side / 2.f;
+}
+
+
+void EdgeBatch::refreshGeometry(const Edge* edge) {
+    auto found = this->slot_indices.find(edge);
+    if (found != this->slot_indices.end()) this->fillGeometry(found->second);
+}
+
+
+void EdgeBatch::fillColor(uint32_t index) {
+    EdgeSlot& slot = this->slots[index];
+    slot.state = slot.edge->getState();
+    sf::Color color = Edge::getStateColor(slot.state);
+    for (int i = 0; i < 4; i++) this->quads[4 * index + i].color = color;
+    for (int i = 0; i < 2; i++) this->lines[2 * index + i].color = color;
+}
+
+
+void EdgeBatch::render(sf::RenderTarget& target) {
+    for (uint32_t index = 0; index < this->slots.size(); index++) {
+        if (this->slots[index].edge->getState() != this->slots[index].state) this->fillColor(index);
+    }
+    float units_per_pixel = target.getView().getSize().x / (float)target.getSize().x;
+    target.draw((units_per_pixel >= EDGE_LINES_ZOOM) ? this->lines : this->quads);
+}
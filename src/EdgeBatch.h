@@ -0,0 +1,94 @@
+/**
+ * This code represents the geometry of all the edges of a graph, kept in vertex arrays so that they are drawn with a
+ * single draw call instead of one per edge.
+ *
+ * Every edge has a slot of 4 vertices in an array of quads, and of 2 vertices in an array of lines that is drawn
+ * instead once the view is zoomed out so far that an edge is thinner than a pixel. The graph refreshes the geometry
+ * of the edges whose nodes moved, and a slot remembers the state it was last colored with, so that only the slots
+ * whose state changed are colored again when the edges are drawn.
+ */
+
+#ifndef ALGOVIZ_EDGEBATCH_H
+#define ALGOVIZ_EDGEBATCH_H
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "Edge.h"
+#include "SFML/Graphics.hpp"
+
+#define EDGE_LINES_ZOOM (float)EDGE_WIDTH // the view units per pixel from which edges are thinner than a pixel
+
+
+class EdgeBatch {
+    struct EdgeSlot {
+        std::shared_ptr<Edge> edge;
+        EdgeState state; // the state of the edge when the slot was last colored
+    };
+
+    std::vector<EdgeSlot> slots;
+    std::unordered_map<const Edge*, uint32_t> slot_indices; // edge -> the index of its slot
+    sf::VertexArray quads = sf::VertexArray(sf::Quads); // 4 vertices for every slot
+    sf::VertexArray lines = sf::VertexArray(sf::Lines); // 2 vertices for every slot
+
+
+    /** Fills the vertices of a slot, and the rectangle of its edge, from the current positions of the edge's nodes.
+     *
+     * @param index - the index of the slot
+     */
+    void fillGeometry(uint32_t index);
+
+
+    /** Fills the colors of a slot's vertices from the current state of its edge.
+     *
+     * @param index - the index of the slot
+     */
+    void fillColor(uint32_t index);
+
+public:
+
+    /** Constructs a batch with no edges.
+     *
+     */
+    EdgeBatch() = default;
+
+
+    /** Gives an edge a slot in the batch.
+     *
+     * @param edge - the edge to add, which isn't in the batch yet
+     */
+    void add(const std::shared_ptr<Edge>& edge);
+
+
+    /** Takes an edge out of the batch, moving the edge of the last slot into its slot.
+     *
+     * @param edge - the edge to remove, nothing happens if it isn't in the batch
+     */
+    void remove(const Edge* edge);
+
+
+    /** Refills the vertices of an edge after one of its nodes moved.
+     *
+     * @param edge - the edge to refresh, nothing happens if it isn't in the batch
+     */
+    void refreshGeometry(const Edge* edge);
+
+
+    /** Recolors the slots of the edges whose state changed since they were last drawn, then draws all of them at
+     * once.
+     *
+     * @param target - the render target to draw the edges on
+     */
+    void render(sf::RenderTarget& target);
+
+
+    /** Default destructor.
+     *
+     */
+    ~EdgeBatch() = default;
+
+};
+
+
+#endif //ALGOVIZ_EDGEBATCH_H
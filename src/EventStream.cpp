@@ -0,0 +1,191 @@
+#include "EventStream.h"
+#include <algorithm>
+#include <climits>
+#include <unordered_map>
+
+
+EventStream::EventStream(std::shared_ptr<const AdjacencyArray> adjacency): adjacency(std::move(adjacency)) {
+    const AdjacencyArray& snapshot = *this->adjacency;
+    uint32_t nodes_count = snapshot.size();
+    this->nodes.reserve(nodes_count);
+    this->node_states.resize(nodes_count, NODE_UNDISCOVERED);
+    this->distances.resize(nodes_count, INT_MAX);
+    this->weights.resize(nodes_count, INT_MAX);
+    // parents from earlier runs are stale, so every node starts this run without one
+    this->parents.resize(nodes_count, INVALID_NODE_ID);
+    for (uint32_t id = 0; id < nodes_count; id++) {
+        const std::shared_ptr<Node>& node = snapshot.getNode(id);
+        this->nodes.push_back(node);
+        if (!node) continue;
+        this->node_states[id] = node->getState();
+        this->distances[id] = node->getDistance();
+        this->weights[id] = node->getWeight();
+    }
+    // every edge of an undirected graph sits in the rows of both of its nodes, but it's recorded under one index
+    int positions_count = nodes_count ? snapshot.rowEnd(nodes_count - 1) : 0;
+    std::unordered_map<const Edge*, uint32_t> edge_indices;
+    this->edge_ids.reserve(positions_count);
+    for (int position = 0; position < positions_count; position++) {
+        const std::shared_ptr<Edge>& edge = snapshot.getEdge(position);
+        auto inserted = edge_indices.emplace(edge.get(), (uint32_t)this->edges.size());
+        if (inserted.second) {
+            this->edges.push_back(edge);
+            this->edge_states.push_back(edge->getState());
+        }
+        this->edge_ids.push_back(inserted.first->second);
+    }
+
+    this->keyframe_interval = std::max<size_t>(EVENT_STREAM_KEYFRAME_EVENTS, nodes_count + this->edges.size());
+    this->addKeyframe();
+}
+
+
+const AdjacencyArray& EventStream::getAdjacency() const {
+    return *this->adjacency;
+}
+
+
+void EventStream::record(StepEventType type, uint32_t target, int value) {
+    this->events.push_back({target, value, type});
+}
+
+
+NodeState EventStream::getNodeState(uint32_t id) const {
+    return this->node_states[id];
+}
+
+
+void EventStream::setNodeState(uint32_t id, NodeState state) {
+    this->node_states[id] = state;
+    this->record(EVENT_NODE_STATE, id, state);
+}
+
+
+int EventStream::getDistance(uint32_t id) const {
+    return this->distances[id];
+}
+
+
+void EventStream::setDistance(uint32_t id, int distance) {
+    this->distances[id] = distance;
+    this->record(EVENT_NODE_DISTANCE, id, distance);
+}
+
+
+int EventStream::getWeight(uint32_t id) const {
+    return this->weights[id];
+}
+
+
+void EventStream::setWeight(uint32_t id, int weight) {
+    this->weights[id] = weight;
+    this->record(EVENT_NODE_WEIGHT, id, weight);
+}
+
+
+uint32_t EventStream::getParent(uint32_t id) const {
+    return this->parents[id];
+}
+
+
+void EventStream::setParent(uint32_t id, uint32_t parent_id) {
+    this->parents[id] = parent_id;
+    this->record(EVENT_NODE_PARENT, id, (int)parent_id);
+}
+
+
+void EventStream::setEdgeState(int position, EdgeState state) {
+    uint32_t edge_id = this->edge_ids[position];
+    this->edge_states[edge_id] = state;
+    this->record(EVENT_EDGE_STATE, edge_id, state);
+}
+
+
+void EventStream::endStep() {
+    this->step_ends.push_back(this->events.size());
+    // a keyframe costs about as much as replaying keyframe_interval events, so that bounds the cost of a seek
+    if (this->events.size() - this->stepBegin(this->keyframes.back().step) >= this->keyframe_interval) {
+        this->addKeyframe();
+    }
+}
+
+
+void EventStream::finish() {
+    if (this->events.size() > this->stepBegin(this->step_ends.size())) this->endStep();
+}
+
+
+void EventStream::addKeyframe() {
+    this->keyframes.push_back({this->step_ends.size(), this->node_states, this->distances, this->weights,
+                               this->parents, this->edge_states});
+}
+
+
+size_t EventStream::stepBegin(size_t step) const {
+    if (step > this->step_ends.size()) return this->events.size();
+    return (step == 0) ? 0 : this->step_ends[step - 1];
+}
+
+
+void EventStream::seek(size_t step) {
+    step = std::min(step, this->step_ends.size());
+    auto after_keyframe = std::upper_bound(this->keyframes.begin(), this->keyframes.end(), step,
+                                           [](size_t target_step, const StreamKeyframe& keyframe) {
+        return target_step < keyframe.step;
+    });
+    const StreamKeyframe& keyframe = *(after_keyframe - 1);
+    if (step < this->current_step || keyframe.step > this->current_step) {
+        this->restoreKeyframe(keyframe);
+        this->current_step = keyframe.step;
+    }
+    for (size_t i = this->stepBegin(this->current_step); i < this->stepBegin(step); i++) {
+        this->applyEvent(this->events[i]);
+    }
+    this->current_step = step;
+}
+
+
+size_t EventStream::getCurrentStep() const {
+    return this->current_step;
+}
+
+
+size_t EventStream::getStepsCount() const {
+    return this->step_ends.size();
+}
+
+
+void EventStream::applyEvent(const StepEvent& event) {
+    switch (event.type) {
+        case EVENT_NODE_STATE:
+            this->nodes[event.target]->setState((NodeState)event.value);
+            break;
+        case EVENT_EDGE_STATE:
+            this->edges[event.target]->setState((EdgeState)event.value);
+            break;
+        case EVENT_NODE_DISTANCE:
+            this->nodes[event.target]->setDistance(event.value);
+            break;
+        case EVENT_NODE_WEIGHT:
+            this->nodes[event.target]->setWeight(event.value);
+            break;
+        case EVENT_NODE_PARENT:
+            this->nodes[event.target]->setParent((uint32_t)event.value);
+            break;
+    }
+}
+
+
+void EventStream::restoreKeyframe(const StreamKeyframe& keyframe) {
+    for (uint32_t id = 0; id < this->nodes.size(); id++) {
+        const std::shared_ptr<Node>& node = this->nodes[id];
+        if (!node) continue;
+        node->setState(keyframe.node_states[id]);
+        node->setDistance(keyframe.distances[id]);
+        node->setWeight(keyframe.weights[id]);
+        node->setParent(keyframe.parents[id]);
+    }
+    for (uint32_t edge_id = 0; edge_id < this->edges.size(); edge_id++) {
+        this->edges[edge_id]->setState(keyframe.edge_states[edge_id]);
+    }
+}
@@ -0,0 +1,203 @@
+/**
+ * This code represents a recorded run of a graph algorithm as a stream of step events.
+ *
+ * The algorithm never touches the nodes, the edges or anything else that is rendered. It reads and changes a
+ * private copy of the node states, distances, weights and parents kept by the stream, and every change is recorded
+ * as a small event. The events are grouped into steps, where every step is one frame of the animation, and the
+ * playback applies the events of the published steps to the real nodes and edges at its own pace, so the algorithm
+ * can run ahead of what is shown.
+ *
+ * The published steps are kept, so the playback can seek to any step of the run. Every few thousand events the
+ * recording also keeps a keyframe with the full state of the nodes and edges, so seeking restores at most one
+ * keyframe and replays the events recorded after it, instead of replaying the run from its first step.
+ *
+ * The stream keeps the adjacency snapshot the algorithm runs on, and the nodes and edges it plays back to are the
+ * ones of that snapshot, so the graph can be edited while the run plays.
+ */
+
+#ifndef ALGOVIZ_EVENTSTREAM_H
+#define ALGOVIZ_EVENTSTREAM_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Node.h"
+#include "Edge.h"
+#include "AdjacencyArray.h"
+
+#define EVENT_STREAM_KEYFRAME_EVENTS 4096 // the least number of events recorded between two keyframes
+
+
+enum StepEventType : uint8_t {
+    EVENT_NODE_STATE,
+    EVENT_EDGE_STATE,
+    EVENT_NODE_DISTANCE,
+    EVENT_NODE_WEIGHT,
+    EVENT_NODE_PARENT
+};
+
+
+struct StepEvent {
+    uint32_t target; // the id of the node, or the index of the edge
+    int value; // the new state, distance, weight or parent id
+    StepEventType type;
+};
+
+
+struct StreamKeyframe {
+    size_t step; // the number of steps applied to get to this state
+    std::vector<NodeState> node_states;
+    std::vector<int> distances;
+    std::vector<int> weights;
+    std::vector<uint32_t> parents;
+    std::vector<EdgeState> edge_states;
+};
+
+
+class EventStream {
+    std::shared_ptr<const AdjacencyArray> adjacency; // the snapshot of the graph the algorithm runs on
+    std::vector<std::shared_ptr<Node>> nodes; // node id -> node, nullptr for free ids
+    std::vector<std::shared_ptr<Edge>> edges; // edge index -> edge, every edge appears once
+    std::vector<uint32_t> edge_ids; // adjacency position -> edge index
+
+    // the algorithm's copy of the nodes, indexed by node id
+    std::vector<NodeState> node_states;
+    std::vector<int> distances;
+    std::vector<int> weights;
+    std::vector<uint32_t> parents;
+    std::vector<EdgeState> edge_states; // indexed by edge index
+    size_t keyframe_interval; // the number of events recorded between two keyframes
+
+    std::vector<StepEvent> events; // the events of all the published steps, then the events of the step being recorded
+    std::vector<size_t> step_ends; // the index in events after the last event of every published step
+    std::vector<StreamKeyframe> keyframes; // in step order, the first one holds the state before the first step
+    size_t current_step = 0; // the number of steps applied to the nodes and edges
+
+    /** Appends an event to the step being recorded.
+     *
+     * @param type - the type of the event
+     * @param target - the id of the node, or the index of the edge
+     * @param value - the new value
+     */
+    void record(StepEventType type, uint32_t target, int value);
+
+
+    /** Keeps the current state of the recording as a keyframe.
+     *
+     */
+    void addKeyframe();
+
+
+    /** Returns the index in events of the first event of a step.
+     *
+     * @param step - the index of the step
+     * @return The index of the first event, or events.size() if the step wasn't published.
+     */
+    size_t stepBegin(size_t step) const;
+
+
+    /** Applies an event to the nodes and edges.
+     *
+     * @param event - the event to apply
+     */
+    void applyEvent(const StepEvent& event);
+
+
+    /** Applies the full state of a keyframe to the nodes and edges.
+     *
+     * @param keyframe - the keyframe to restore
+     */
+    void restoreKeyframe(const StreamKeyframe& keyframe);
+
+public:
+
+    /** Constructs an empty stream, copying the current states, distances and weights of the graph's nodes and the
+     * current states of its edges.
+     *
+     * Has to be called by the thread that owns the nodes, before the algorithm starts recording.
+     *
+     * @param adjacency - the adjacency snapshot of the graph the algorithm runs on, kept by the stream
+     */
+    explicit EventStream(std::shared_ptr<const AdjacencyArray> adjacency);
+
+
+    //----Recording, called by the algorithm----
+
+    /** Returns the adjacency snapshot the algorithm runs on, which doesn't change when the graph is edited.
+     *
+     * @return reference to the adjacency array the stream was created with
+     */
+    const AdjacencyArray& getAdjacency() const;
+
+    NodeState getNodeState(uint32_t id) const;
+    void setNodeState(uint32_t id, NodeState state);
+
+    int getDistance(uint32_t id) const;
+    void setDistance(uint32_t id, int distance);
+
+    int getWeight(uint32_t id) const;
+    void setWeight(uint32_t id, int weight);
+
+    /** Returns the id of the node a node was reached from in this run.
+     *
+     * @param id - the id of the node
+     * @return The id of the parent node, or INVALID_NODE_ID if the node has no parent yet.
+     */
+    uint32_t getParent(uint32_t id) const;
+    void setParent(uint32_t id, uint32_t parent_id);
+
+    /** Records a new state for an edge.
+     *
+     * @param position - an adjacency position of the edge
+     * @param state - the new state of the edge
+     */
+    void setEdgeState(int position, EdgeState state);
+
+
+    /** Ends the step being recorded and publishes it to the playback.
+     *
+     */
+    void endStep();
+
+
+    /** Publishes the last step of the algorithm, if it has any events.
+     *
+     */
+    void finish();
+
+
+    //----Playback----
+
+    /** Shows the nodes and edges as they were after a number of steps of the run.
+     *
+     * Seeking forward applies the steps in between, unless a keyframe is closer. Seeking backward restores the
+     * last keyframe before the step and applies the steps after it.
+     *
+     * @param step - the number of steps to show, clamped to the number of published steps
+     */
+    void seek(size_t step);
+
+
+    /** Returns the number of steps applied to the nodes and edges.
+     *
+     * @return The current step of the playback.
+     */
+    size_t getCurrentStep() const;
+
+
+    /** Returns the number of published steps.
+     *
+     * @return The number of steps that can be seeked to.
+     */
+    size_t getStepsCount() const;
+
+
+    /** Default destructor.
+     *
+     */
+    ~EventStream() = default;
+
+};
+
+
+#endif //ALGOVIZ_EVENTSTREAM_H
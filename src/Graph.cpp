@@ -3,6 +3,10 @@
 //
 #include <iostream>
 #include <queue>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include "Graph.h"
 #include "Node.h"
 #include "Visualizer.h"
@@ -10,145 +14,171 @@
 #include <mutex>
 #include "utils.h"
 
-#define WAIT_TIME_MS 100
+#define ASTAR_HEURISTIC_SCALE 0.95f
 
-#define CHECK_IF_algo_thread_should_end \
-if (algo_thread_should_end) {           \
-    algo_thread_is_running = false; \
-    algo_thread_is_finished = true;\
-    return;                 \
-    }
-
-#define CHECK_IF_algo_thread_should_end_REC \
-if (algo_thread_should_end) {           \
-    algo_thread_is_running = false; \
-    algo_thread_is_finished = true;\
-    return false;                 \
-    }
-
-
-extern std::mutex window_lock;
-extern bool algo_thread_is_running;
-extern bool algo_thread_is_finished;
-extern bool algo_thread_should_end;
+extern std::recursive_mutex window_lock;
+extern std::atomic<bool> playback_should_skip;
+extern std::atomic<unsigned int> steps_per_second;
+extern std::atomic<bool> playback_is_paused;
 extern VisMode current_algo_mode;
 
 
 Graph::Graph(const Graph &other) {
-    this->nodes_num = other.nodes_num;
-    this->edges_num = other.edges_num;
-    this->name_count = other.name_count;
-    this->start_node = other.start_node;
-    this->nodes_list = other.nodes_list;
-    this->neighbors_list = other.neighbors_list;
-    this->edges_list = other.edges_list;
+    // the nodes and edges are copied rather than shared, so that editing or running an algorithm on either graph
+    // doesn't change the other one
     this->directed = other.directed;
+    this->dijkstra_queue_type = other.dijkstra_queue_type;
+    this->bidirectional_search = other.bidirectional_search;
+    this->headless_search = other.headless_search;
+    this->search_threads = other.search_threads;
+    this->free_ids = other.free_ids;
+    this->nodes_list.resize(other.nodes_list.size());
+    this->neighbors_list.resize(other.neighbors_list.size());
+    this->edges_list.resize(other.edges_list.size());
+    this->node_table->grow((uint32_t)other.nodes_list.size());
+    for (uint32_t id = 0; id < other.nodes_list.size(); id++) {
+        const std::shared_ptr<Node>& node = other.nodes_list[id];
+        if (!node) continue;
+        sf::Vector2f position = node->getPosition();
+        std::shared_ptr<Node> node_copy = std::make_shared<Node>(node->getName(), position.x, position.y);
+        node_copy->attach(this->node_table, id);
+        this->nodes_list[id] = node_copy;
+        this->node_grid.insert(id, position);
+        this->nodes_num++;
+    }
+    // the nodes keep the state the last run left them in, as the edges below do
+    *this->node_table = *other.node_table;
+
+    for (const auto& [key, edge] : other.edge_index) {
+        std::shared_ptr<Edge> edge_copy = std::make_shared<Edge>(this->nodes_list[edge->getFirstNode()->getId()],
+                                                                 this->nodes_list[edge->getSecondNode()->getId()]);
+        this->addEdge(edge_copy);
+        edge_copy->setState(edge->getState());
+    }
+    if (other.start_node) this->start_node = this->nodes_list[other.start_node->getId()];
+    if (other.target_node) this->target_node = this->nodes_list[other.target_node->getId()];
+}
+
+
+Graph& Graph::operator=(const Graph& other) {
+    if (this != &other) *this = Graph(other);
+    return *this;
 }
 
 
 void Graph::render(sf::RenderWindow& target, sf::Font* font) {
-    std::string node_text;
-    for (auto &node: this->nodes_list) {
-        switch (current_algo_mode) {
-            case DIJKSTRA: {
-                node_text = std::to_string(node.second->getWeight());
-                break;
-            }
-            default: {
-                node_text = std::to_string(node.second->getDistance());
-                break;
-            }
-        }
-        node.second->render(target, node_text);
-    }
+    this->updateMovedNodes();
+    this->node_batch.render(target, this->nodes_list);
+    bool shows_weights = current_algo_mode == DIJKSTRA || current_algo_mode == ASTAR;
+    this->label_batch.render(target, *font, this->nodes_list, shows_weights);
 // rendered nodes first then edges to show edges when they cross nodes
-    for (auto &node: this->nodes_list) {
-        for (auto &edge: this->edges_list[node.first]) {
-            edge->correctEdgeCoordinates();
-            edge->render(target);
-        }
-    }
+    this->edge_batch.render(target);
 }
 
 
-std::shared_ptr<Node> Graph::addNode(float pos_x, float pos_y, sf::Font* text_font) {
-    std::string node_name = generateNodeName();
-    std::shared_ptr<Node> node_ptr = std::make_shared<Node>(node_name, pos_x, pos_y, text_font);
+std::shared_ptr<Node> Graph::addNode(float pos_x, float pos_y) {
+    std::shared_ptr<Node> node_ptr = std::make_shared<Node>("", pos_x, pos_y);
     if (!checkValidPosition(*node_ptr)) return nullptr;
-    this->nodes_list[node_name] = node_ptr;
-    this->neighbors_list[node_name] = {};
-    this->nodes_num++;
-    this->name_count++;
+    this->addNode(node_ptr);
     if (this->nodes_num == 1) setStartNode(node_ptr);
     return node_ptr;
 }
 
 
 void Graph::addNode(std::shared_ptr<Node>& node) {
-    this->nodes_list[node->getName()] = node;
-    this->neighbors_list[node->getName()] = {};
+    uint32_t node_id = this->allocateNodeId();
+    this->node_table->grow(node_id + 1);
+    node->attach(this->node_table, node_id);
+    node->setName(generateNodeName(node_id));
+    this->nodes_list[node_id] = node;
+    this->node_grid.insert(node_id, node->getPosition());
     this->nodes_num++;
-    this->name_count = std::max(this->name_count, std::stoi(node->getName().substr(5, node->getName().size()-5))+1);
+    this->adjacency_is_valid = false;
+    this->recording = nullptr;
 }
 
 
-void Graph::removeNode(const std::string& node_name) {
-    if (this->nodes_list.find(node_name) == this->nodes_list.end()) return;
-    bool start_node_isChanged;
-
-    std::shared_ptr<Node> node_to_delete = this->nodes_list[node_name];
+void Graph::removeNode(uint32_t node_id) {
+    if (node_id >= this->nodes_list.size() || !this->nodes_list[node_id]) return;
+    bool start_node_isChanged = false;
 
     // update the start node if it's the deleted node
-    if (node_name == this->start_node->getName()) {
+    if (node_id == this->start_node->getId()) {
         start_node_isChanged = true;
     }
 
     // go over all the nodes' neighbors and delete the edges between them
-    for (const std::shared_ptr<Edge>& edge : this->edges_list[node_name]) {
-        if (edge->getFirstNode()->getName() == node_name) {
-            this->edges_list[edge->getSecondNode()->getName()].erase(edge);
+    for (const std::shared_ptr<Edge>& edge : this->edges_list[node_id]) {
+        if (edge->getFirstNode()->getId() == node_id) {
+            this->edges_list[edge->getSecondNode()->getId()].erase(edge);
         }
         else {
-            this->edges_list[edge->getFirstNode()->getName()].erase(edge);
+            this->edges_list[edge->getFirstNode()->getId()].erase(edge);
         }
+        this->edge_index.erase(edgeKey(edge->getFirstNode()->getId(), edge->getSecondNode()->getId()));
+        this->edge_batch.remove(edge.get());
+        this->edges_num--;
     }
 
     // erase the node from every neighboring node's list
-    for (const std::shared_ptr<Node>& neighbor_node : this->neighbors_list[node_name]) {
-        neighbors_list[neighbor_node->getName()].erase(node_to_delete);
+    for (uint32_t neighbor_id : this->neighbors_list[node_id]) {
+        this->neighbors_list[neighbor_id].erase(node_id);
     }
 
-    this->nodes_list.erase(node_name);
-    this->edges_list.erase(node_name); // delete edges list entry
-    this->neighbors_list.erase(node_name); // erase the node's neighbors entry from hashmap
+    if (this->target_node == this->nodes_list[node_id]) this->target_node = nullptr;
+    this->node_grid.remove(node_id);
+    this->nodes_list[node_id]->detach();
+    this->nodes_list[node_id] = nullptr;
+    this->edges_list[node_id].clear(); // delete edges list entry
+    this->neighbors_list[node_id].clear(); // erase the node's neighbors entry
+    this->free_ids.push_back(node_id);
+    this->nodes_num--;
     if (start_node_isChanged) {
-        if (this->nodes_list.empty()) this->start_node = nullptr;
-        else setStartNode(nodes_list.begin()->second);
+        this->start_node = nullptr;
+        for (const auto& node : this->nodes_list) {
+            if (node) {
+                setStartNode(node);
+                break;
+            }
+        }
     }
-    this->nodes_num--;
+    this->adjacency_is_valid = false;
+    this->recording = nullptr;
 }
 
 
 void Graph::addEdge(std::shared_ptr<Edge>& edge) {
     if (this->containsEdge(edge)) return;
-    std::shared_ptr<Node> node1 = edge->getFirstNode();
-    std::shared_ptr<Node> node2 = edge->getSecondNode();
+    uint32_t node1_id = edge->getFirstNode()->getId();
+    uint32_t node2_id = edge->getSecondNode()->getId();
+    // a node that was removed meanwhile has no id anymore, and no edge can be added to it
+    if (node1_id == INVALID_NODE_ID || node2_id == INVALID_NODE_ID) return;
     this->edges_num++;
-    this->edges_list[edge->getFirstNode()->getName()].insert(edge);
-    this->edges_list[edge->getSecondNode()->getName()].insert(edge); // done twice because each edge exists in 2 lists, one for each node it connects
-    this->neighbors_list[node1->getName()].insert(node2);
-    this->neighbors_list[node2->getName()].insert(node1);
+    this->edges_list[node1_id].insert(edge);
+    this->edges_list[node2_id].insert(edge); // done twice because each edge exists in 2 lists, one for each node it connects
+    this->neighbors_list[node1_id].insert(node2_id);
+    this->neighbors_list[node2_id].insert(node1_id);
+    this->edge_index[edgeKey(node1_id, node2_id)] = edge;
+    this->edge_batch.add(edge);
+    this->adjacency_is_valid = false;
+    this->recording = nullptr;
 }
 
 
 void Graph::removeEdge(const std::shared_ptr<Edge>& to_delete) {
-    this->edges_list[to_delete->getFirstNode()->getName()].erase(to_delete);
-    this->edges_list[to_delete->getSecondNode()->getName()].erase(to_delete);
-    std::shared_ptr<Node> firstNode = to_delete->getFirstNode();
-    std::shared_ptr<Node> secondNode = to_delete->getSecondNode();
-    this->neighbors_list[firstNode->getName()].erase(secondNode);
-    this->neighbors_list[secondNode->getName()].erase(firstNode);
+    uint32_t node1_id = to_delete->getFirstNode()->getId();
+    uint32_t node2_id = to_delete->getSecondNode()->getId();
+    // the edges of a removed node were removed with it
+    if (node1_id == INVALID_NODE_ID || node2_id == INVALID_NODE_ID) return;
+    this->edges_list[node1_id].erase(to_delete);
+    this->edges_list[node2_id].erase(to_delete);
+    this->neighbors_list[node1_id].erase(node2_id);
+    this->neighbors_list[node2_id].erase(node1_id);
+    this->edge_index.erase(edgeKey(node1_id, node2_id));
+    this->edge_batch.remove(to_delete.get());
     this->edges_num--;
+    this->adjacency_is_valid = false;
+    this->recording = nullptr;
 }
 
 void Graph::removeTargetNode() {
@@ -165,22 +195,9 @@ const std::shared_ptr<Node>& Graph::getStartNode() const {
 }
 
 bool Graph::containsEdge(const std::shared_ptr<Edge>& edge) {
-    std::string node1_name = edge->getFirstNode()->getName();
-    std::string node2_name = edge->getSecondNode()->getName();
-
-    if (this->edges_list.find(node1_name) == this->edges_list.end() ||
-        this->edges_list.find(node2_name) == this->edges_list.end())
-        return false;
-
-    for (const auto& current_edge: edges_list[edge->getFirstNode()->getName()]) {
-        if ((current_edge->getFirstNode()->getName() == node1_name &&
-            current_edge->getSecondNode()->getName() == node2_name) ||
-            (current_edge->getSecondNode()->getName() == node1_name &&
-            current_edge->getFirstNode()->getName() == node2_name))
-            return true;
-    }
-
-    return false;
+    uint32_t node1_id = edge->getFirstNode()->getId();
+    uint32_t node2_id = edge->getSecondNode()->getId();
+    return this->edge_index.find(edgeKey(node1_id, node2_id)) != this->edge_index.end();
 }
 
 void Graph::setStartNode(const std::shared_ptr<Node>& new_start_node) {
@@ -197,6 +214,42 @@ void Graph::setStartNode(const std::shared_ptr<Node>& new_start_node) {
 }
 
 
+void Graph::setDijkstraQueue(PriorityQueueType queue_type) {
+    this->dijkstra_queue_type = queue_type;
+}
+
+
+PriorityQueueType Graph::getDijkstraQueue() const {
+    return this->dijkstra_queue_type;
+}
+
+
+void Graph::setBidirectionalSearch(bool is_bidirectional) {
+    this->bidirectional_search = is_bidirectional;
+}
+
+
+bool Graph::isBidirectionalSearch() const {
+    return this->bidirectional_search;
+}
+
+
+void Graph::setHeadlessSearch(bool is_headless, unsigned int threads_count) {
+    this->headless_search = is_headless;
+    this->search_threads = threads_count;
+}
+
+
+bool Graph::isHeadlessSearch() const {
+    return this->headless_search;
+}
+
+
+unsigned int Graph::getSearchThreads() const {
+    return this->search_threads;
+}
+
+
 void Graph::setTargetNode(const std::shared_ptr<Node> &new_target_node) {
     if (!new_target_node) return;
     if (this->target_node) this->target_node->setState(NODE_UNDISCOVERED);
@@ -206,28 +259,26 @@ void Graph::setTargetNode(const std::shared_ptr<Node> &new_target_node) {
 
 
 std::shared_ptr<Node> Graph::getNodeByPosition(float pos_x, float pos_y) {
-    for (const auto& node: this->nodes_list) {
-        if (node.second->getShape().getGlobalBounds().contains(pos_x, pos_y)) {
-            return node.second;
-        }
-    }
-    return nullptr;
+    this->updateMovedNodes();
+    uint32_t node_id = this->node_grid.find({pos_x, pos_y}, true, [&](uint32_t id) {
+        return this->nodes_list[id]->contains(pos_x, pos_y);
+    });
+    return (node_id == INVALID_NODE_ID) ? nullptr : this->nodes_list[node_id];
 }
 
 
-std::shared_ptr<Node> Graph::getCollidedNode(const std::shared_ptr<Node> &moving_node) const {
-    for (const auto& node: this->nodes_list) {
-        if (node.second->checkBoundsCollision(moving_node) && node.second != moving_node) {
-            return node.second;
-        }
-    }
-    return nullptr;
+std::shared_ptr<Node> Graph::getCollidedNode(const std::shared_ptr<Node> &moving_node) {
+    this->updateMovedNodes();
+    uint32_t node_id = this->node_grid.find(moving_node->getPosition(), false, [&](uint32_t id) {
+        return this->nodes_list[id] != moving_node && this->nodes_list[id]->checkBoundsCollision(moving_node);
+    });
+    return (node_id == INVALID_NODE_ID) ? nullptr : this->nodes_list[node_id];
 }
 
 
 std::shared_ptr<Edge> Graph::getEdgeByPosition(float pos_x, float pos_y) {
     for (const auto& edges: edges_list) {
-        for (const auto& edge: edges.second) {
+        for (const auto& edge: edges) {
             if (edge->getShape().getGlobalBounds().contains(pos_x, pos_y)) {
                 return edge;
             }
@@ -244,221 +295,693 @@ void Graph::setToggledNode(std::shared_ptr<Node>& to_toggle) {
 }
 
 void Graph::runBFS(sf::RenderWindow& window, Toolbar& toolbar, sf::View& original_view, sf::View& current_view,
-                   sf::Font* font, sf::FloatRect& grid_bounds, bool wait) {
-    algo_thread_is_running = true;
+                   sf::Font* font, sf::FloatRect& grid_bounds, bool wait, std::stop_token stop_token) {
+    std::unique_lock<std::recursive_mutex> graph_guard(window_lock);
+    this->untoggle();
+    if (!this->start_node) return;
+    uint32_t start_id = this->start_node->getId();
+    std::function<AlgorithmSteps(EventStream&)> record = [this, start_id](EventStream& stream) {
+        return this->recordBFS(stream, start_id);
+    };
+    if (this->bidirectional_search && this->target_node && this->target_node != this->start_node) {
+        uint32_t target_id = this->target_node->getId();
+        record = [this, start_id, target_id](EventStream& stream) {
+            return this->recordBidirectionalBFS(stream, start_id, target_id);
+        };
+    }
+    else if ((!wait || this->headless_search) && !this->target_node) {
+        // only the end of the run is shown, so the levels of the search are spread over the cores
+        this->reset();
+        unsigned int threads_count = this->search_threads;
+        record = [this, start_id, threads_count, stop_token](EventStream& stream) {
+            return this->recordHeadlessBFS(stream, start_id, threads_count, stop_token);
+        };
+        wait = false;
+    }
+    this->runRecorded(record, window, toolbar, original_view, current_view, font, grid_bounds, wait, stop_token,
+                      graph_guard);
+}
+
+
+void Graph::runDFS(sf::RenderWindow& window, Toolbar& toolbar, sf::View& original_view, sf::View& current_view,
+                   sf::Font* font, sf::FloatRect& grid_bounds, bool wait, std::stop_token stop_token) {
+    std::unique_lock<std::recursive_mutex> graph_guard(window_lock);
     this->untoggle();
     if (!this->start_node) return;
+    uint32_t start_id = this->start_node->getId();
+    this->runRecorded([this, start_id](EventStream& stream) { return this->recordDFS(stream, start_id); },
+                      window, toolbar, original_view, current_view, font, grid_bounds, wait, stop_token, graph_guard);
+}
+
+
+void Graph::runDijkstra(sf::RenderWindow& window, Toolbar& toolbar, sf::View& original_view, sf::View& current_view,
+                        sf::Font* font, sf::FloatRect& grid_bounds, bool wait, std::stop_token stop_token) {
+    std::unique_lock<std::recursive_mutex> graph_guard(window_lock);
+    if (this->bidirectional_search && this->start_node && this->target_node && this->target_node != this->start_node) {
+        if (wait) this->untoggle();
+        this->reset();
+        this->calculate_distances();
+        this->refreshAdjacencyWeights();
+        uint32_t start_id = this->start_node->getId();
+        uint32_t target_id = this->target_node->getId();
+        this->runRecorded([this, start_id, target_id](EventStream& stream) {
+            return this->recordBidirectionalDijkstra(stream, start_id, target_id);
+        }, window, toolbar, original_view, current_view, font, grid_bounds, wait, stop_token, graph_guard);
+        return;
+    }
+    if ((!wait || this->headless_search) && this->start_node && !this->target_node) {
+        // only the end of the run is shown, so the search doesn't have to settle the nodes one by one
+        if (wait) this->untoggle();
+        this->reset();
+        this->calculate_distances();
+        this->refreshAdjacencyWeights();
+        uint32_t start_id = this->start_node->getId();
+        unsigned int threads_count = this->search_threads;
+        this->runRecorded([this, start_id, threads_count, stop_token](EventStream& stream) {
+            return this->recordHeadlessDijkstra(stream, start_id, threads_count, stop_token);
+        }, window, toolbar, original_view, current_view, font, grid_bounds, false, stop_token, graph_guard);
+        return;
+    }
+    this->shortestPath(window, toolbar, original_view, current_view, font, grid_bounds, wait, false, stop_token,
+                       graph_guard);
+}
+
+
+void Graph::runAStar(sf::RenderWindow& window, Toolbar& toolbar, sf::View& original_view, sf::View& current_view,
+                     sf::Font* font, sf::FloatRect& grid_bounds, bool wait, std::stop_token stop_token) {
+    std::unique_lock<std::recursive_mutex> graph_guard(window_lock);
+    this->shortestPath(window, toolbar, original_view, current_view, font, grid_bounds, wait, true, stop_token,
+                       graph_guard);
+}
+
+
+void Graph::shortestPath(sf::RenderWindow& window, Toolbar& toolbar, sf::View& original_view, sf::View& current_view,
+                         sf::Font* font, sf::FloatRect& grid_bounds, bool wait, bool use_heuristic,
+                         std::stop_token stop_token, std::unique_lock<std::recursive_mutex>& graph_guard) {
+    if (wait) this->untoggle();
+    if (!this->start_node) return;
+    this->reset();
+    this->calculate_distances();
+    this->refreshAdjacencyWeights();
+    const AdjacencyArray& adjacency = this->getAdjacency();
+    // the heuristic reads node positions, so it's computed here rather than by the recording thread
+    std::vector<int> heuristics;
+    if (use_heuristic && this->target_node) {
+        heuristics.resize(adjacency.size(), 0);
+        for (uint32_t id = 0; id < adjacency.size(); id++) {
+            if (adjacency.getNode(id)) heuristics[id] = this->heuristic(adjacency.getNode(id));
+        }
+    }
+    uint32_t start_id = this->start_node->getId();
+    uint32_t target_id = this->target_node ? this->target_node->getId() : INVALID_NODE_ID;
+    this->runRecorded([this, start_id, target_id, &heuristics](EventStream& stream) {
+        return this->recordShortestPath(stream, start_id, target_id, heuristics);
+    }, window, toolbar, original_view, current_view, font, grid_bounds, wait, stop_token, graph_guard);
+}
+
+
+void Graph::runRecorded(const std::function<AlgorithmSteps(EventStream&)>& record, sf::RenderWindow& window,
+                        Toolbar& toolbar, sf::View& original_view, sf::View& current_view, sf::Font* font,
+                        sf::FloatRect& grid_bounds, bool wait, std::stop_token stop_token,
+                        std::unique_lock<std::recursive_mutex>& graph_guard) {
+    // the stream is kept after the run, so that the playback can seek through it
+    std::shared_ptr<EventStream> stream = std::make_shared<EventStream>(this->getAdjacencySnapshot());
+    this->recording = stream;
+    AlgorithmSteps steps = record(*stream);
+    bool is_recorded = false;
+    auto record_steps = [&](size_t steps_count, std::chrono::steady_clock::time_point deadline) {
+        while (!is_recorded && stream->getStepsCount() < steps_count && std::chrono::steady_clock::now() < deadline) {
+            if (steps.next()) stream->endStep();
+            else {
+                stream->finish();
+                is_recorded = true;
+            }
+        }
+    };
+    if (!wait) {
+        // nothing is shown before the end, so the whole run is recorded and applied at once. The algorithm only
+        // touches the stream, so the graph isn't locked while it runs
+        graph_guard.unlock();
+        record_steps(SIZE_MAX, std::chrono::steady_clock::time_point::max());
+        graph_guard.lock();
+        if (stop_token.stop_requested()) {
+            this->recording = nullptr;
+            return;
+        }
+        stream->seek(stream->getStepsCount());
+    }
+
+    // the algorithm only touches the stream, so the graph is only locked while the steps are applied and rendered
+    if (wait) graph_guard.unlock();
+    auto next_frame = std::chrono::steady_clock::now();
+    while (wait) {
+        if (stop_token.stop_requested()) {
+            // the algorithm is suspended between two steps, so it ends by just not resuming it
+            graph_guard.lock();
+            this->recording = nullptr;
+            return;
+        }
+        if (playback_should_skip) {
+            record_steps(SIZE_MAX, std::chrono::steady_clock::time_point::max());
+            graph_guard.lock();
+            stream->seek(stream->getStepsCount());
+            break;
+        }
+        std::chrono::microseconds frame_time(1000000 / PLAYBACK_FPS);
+        if (!playback_is_paused) {
+            // slow speeds show a step a frame and wait longer between frames, fast ones show more steps a frame
+            unsigned int speed = steps_per_second;
+            size_t frame_end;
+            if (speed == 0) {
+                record_steps(SIZE_MAX, std::chrono::steady_clock::now() + frame_time);
+                frame_end = stream->getStepsCount();
+            }
+            else {
+                size_t frame_steps = std::max(speed / PLAYBACK_FPS, 1u);
+                record_steps(stream->getCurrentStep() + frame_steps, std::chrono::steady_clock::time_point::max());
+                frame_end = stream->getCurrentStep() + frame_steps;
+                frame_time = std::chrono::microseconds(1000000 * frame_steps / speed);
+            }
+            graph_guard.lock();
+            stream->seek(frame_end);
+            if (is_recorded && stream->getCurrentStep() == stream->getStepsCount()) break;
+            this->renderFrame(window, toolbar, original_view, current_view, font, grid_bounds);
+            graph_guard.unlock();
+        }
+        next_frame = std::max(next_frame + frame_time, std::chrono::steady_clock::now());
+        // waiting a frame at a time, so that a slow run can still be ended or skipped right away
+        while (!stop_token.stop_requested() && !playback_should_skip && std::chrono::steady_clock::now() < next_frame) {
+            std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(
+                    next_frame - std::chrono::steady_clock::now(), std::chrono::microseconds(1000000 / PLAYBACK_FPS)));
+        }
+    }
+
+    this->renderFrame(window, toolbar, original_view, current_view, font, grid_bounds, false);
+}
+
+
+bool Graph::seekRecording(size_t step) {
+    if (!this->recording) return false;
+    this->recording->seek(step);
+    return true;
+}
+
+
+size_t Graph::getRecordingStep() const {
+    return this->recording ? this->recording->getCurrentStep() : 0;
+}
 
-    std::queue<std::shared_ptr<Node>> bfs_q;
-    std::shared_ptr<Node> previous_node;
-    std::shared_ptr<Edge> current_edge;
-    bfs_q.push(this->start_node);
-    bfs_q.front()->setState(NODE_CURRENT);
-    CHECK_IF_algo_thread_should_end
-    this->renderAndWait(window, toolbar, original_view, current_view, font,grid_bounds, wait);
+
+size_t Graph::getRecordingLength() const {
+    return this->recording ? this->recording->getStepsCount() : 0;
+}
+
+
+AlgorithmSteps Graph::recordBFS(EventStream& stream, uint32_t start_id) const {
+    const AdjacencyArray& adjacency = stream.getAdjacency();
+    std::queue<uint32_t> bfs_q;
+    std::vector<int> parent_edges(adjacency.size(), -1); // adjacency position of the edge each node was reached by
+    bfs_q.push(start_id);
+    stream.setNodeState(start_id, NODE_CURRENT);
+    co_yield {};
 
     while (!bfs_q.empty()) {
-        CHECK_IF_algo_thread_should_end
-        previous_node = bfs_q.front();
-        if (previous_node->getState() == NODE_DONE) {
+        uint32_t previous_index = bfs_q.front();
+        if (stream.getNodeState(previous_index) == NODE_DONE) {
             bfs_q.pop();
             continue;
         }
-        previous_node->setState(NODE_CURRENT);
-        for (const std::shared_ptr<Node>& current_node: this->neighbors_list[previous_node->getName()]) {
-            CHECK_IF_algo_thread_should_end
-            if (current_node->getState() != NODE_DONE && current_node->getState() != NODE_DISCOVERED) {
-                current_edge = getEdgeByNodes(previous_node, current_node);
-                current_edge->setState(EDGE_DISCOVERED);
-                bfs_q.push(current_node);
-                current_node->setParent(previous_node);
-                current_node->setDistance(1 + current_node->getParent()->getDistance());
-                if (current_node->getState() == NODE_TARGET) {
-                    while (bfs_q.front()->getState() != NODE_TARGET) bfs_q.pop();
+        stream.setNodeState(previous_index, NODE_CURRENT);
+        for (int i = adjacency.rowBegin(previous_index); i < adjacency.rowEnd(previous_index); i++) {
+            uint32_t current_index = adjacency.getNeighbor(i);
+            NodeState current_state = stream.getNodeState(current_index);
+            if (current_state != NODE_DONE && current_state != NODE_DISCOVERED) {
+                stream.setEdgeState(i, EDGE_DISCOVERED);
+                bfs_q.push(current_index);
+                stream.setParent(current_index, previous_index);
+                parent_edges[current_index] = i;
+                stream.setDistance(current_index, 1 + stream.getDistance(previous_index));
+                if (current_state == NODE_TARGET) {
+                    while (stream.getNodeState(bfs_q.front()) != NODE_TARGET) bfs_q.pop();
                     break;
                 }
-                current_node->setState(NODE_DISCOVERED);
-                this->renderAndWait(window, toolbar, original_view, current_view, font, grid_bounds, wait);
+                stream.setNodeState(current_index, NODE_DISCOVERED);
+                co_yield {};
             }
         }
-        if (bfs_q.front()->getState() == NODE_TARGET) break;
-        previous_node->setState(NODE_DONE);
+        if (stream.getNodeState(bfs_q.front()) == NODE_TARGET) break;
+        stream.setNodeState(previous_index, NODE_DONE);
         bfs_q.pop();
-        CHECK_IF_algo_thread_should_end
-        this->renderAndWait(window, toolbar, original_view, current_view, font, grid_bounds, wait);
+        co_yield {};
     }
 
     if (!bfs_q.empty()) {
-        CHECK_IF_algo_thread_should_end
-        std::shared_ptr<Node> current_node = bfs_q.front();
-        while (current_node->getParent()) {
-            CHECK_IF_algo_thread_should_end
-            std::shared_ptr<Edge> next_edge = this->getEdgeByNodes(current_node, current_node->getParent());
-            next_edge->setState(EDGE_NEAREST);
-            if (current_node->getState() != NODE_TARGET) current_node->setState(NODE_NEAREST);
-            current_node = current_node->getParent();
-            this->renderAndWait(window, toolbar, original_view, current_view, font, grid_bounds, wait);
+        uint32_t current_index = bfs_q.front();
+        while (stream.getParent(current_index) != INVALID_NODE_ID) {
+            stream.setEdgeState(parent_edges[current_index], EDGE_NEAREST);
+            if (stream.getNodeState(current_index) != NODE_TARGET) stream.setNodeState(current_index, NODE_NEAREST);
+            current_index = stream.getParent(current_index);
+            co_yield {};
         }
-        this->start_node->setState(NODE_NEAREST);
+        stream.setNodeState(start_id, NODE_NEAREST);
     }
+}
+
 
-    this->renderAndWait(window, toolbar, original_view, current_view, font, grid_bounds, false, false);
+AlgorithmSteps Graph::recordDFS(EventStream& stream, uint32_t start_id) const {
+    const AdjacencyArray& adjacency = stream.getAdjacency();
+    // every frame holds a node on the current path and the adjacency position of the next neighbor to try from it
+    std::vector<std::pair<uint32_t, int>> dfs_stack;
+    bool found_target = false;
+    auto discover = [&](uint32_t node_index, uint32_t prev_index, int via_position) {
+        if (prev_index != INVALID_NODE_ID) {
+            stream.setEdgeState(via_position, EDGE_DISCOVERED);
+            stream.setDistance(node_index, stream.getDistance(prev_index) + 1);
+        }
+        if (stream.getNodeState(node_index) == NODE_TARGET) {
+            stream.setParent(node_index, prev_index);
+            found_target = true;
+        }
+        else {
+            stream.setNodeState(node_index, NODE_DISCOVERED);
+            dfs_stack.emplace_back(node_index, adjacency.rowBegin(node_index));
+        }
+    };
 
-    if (wait) {
-        algo_thread_is_finished = true;
+    discover(start_id, INVALID_NODE_ID, -1);
+    co_yield {};
+    while (!dfs_stack.empty()) {
+        uint32_t current_index = dfs_stack.back().first;
+        if (found_target) {
+            // unwinding the path from the target back to the start node
+            stream.setNodeState(current_index, NODE_NEAREST);
+            co_yield {};
+            dfs_stack.pop_back();
+            continue;
+        }
+        if (dfs_stack.back().second == adjacency.rowEnd(current_index)) {
+            stream.setNodeState(current_index, NODE_DONE);
+            co_yield {};
+            dfs_stack.pop_back();
+            continue;
+        }
+        int position = dfs_stack.back().second++;
+        NodeState neighbor_state = stream.getNodeState(adjacency.getNeighbor(position));
+        if (neighbor_state != NODE_DISCOVERED && neighbor_state != NODE_DONE) {
+            discover(adjacency.getNeighbor(position), current_index, position);
+            co_yield {};
+        }
     }
-    algo_thread_is_running = false;
 }
 
 
-void Graph::runDFS(sf::RenderWindow& window, Toolbar& toolbar, sf::View& original_view, sf::View& current_view,
-                   sf::Font* font, sf::FloatRect& grid_bounds, bool wait) {
-    algo_thread_is_running = true;
-    this->untoggle();
-    if (!this->start_node) return;
-
-    dfs(nullptr, this->start_node, window, toolbar, original_view, current_view, font, grid_bounds, wait);
-    this->renderAndWait(window, toolbar, original_view, current_view, font, grid_bounds, false, false);
-
-    if (wait) {
-        algo_thread_is_finished = true;
+bool Graph::searchHeadlessBFS(const AdjacencyArray& adjacency, uint32_t start_id, unsigned int threads_count,
+                              std::stop_token stop_token, std::vector<int>& distances,
+                              std::vector<uint32_t>& parents) const {
+    if (threads_count == 0) threads_count = std::thread::hardware_concurrency();
+    if (threads_count <= 1) {
+        // a single thread gains nothing from the parallel engine, but skips edges with bottom-up steps
+        DirectionOptimizingBFS bfs(adjacency);
+        if (!bfs.run(start_id, stop_token)) return false;
+        distances = bfs.getDistances();
+        parents = bfs.getParents();
+        return true;
     }
-    algo_thread_is_running = false;
+    ParallelBFS bfs(adjacency, threads_count);
+    if (!bfs.run(start_id, stop_token)) return false;
+    distances = bfs.getDistances();
+    parents = bfs.getParents();
+    return true;
 }
 
 
-bool Graph::dfs(const std::shared_ptr<Node>& prev_node, const std::shared_ptr<Node>& curr_node,
-                sf::RenderWindow& window, Toolbar& toolbar, sf::View& original_view, sf::View& current_view,
-                sf::Font* font, sf::FloatRect& grid_bounds, bool wait) {
-    CHECK_IF_algo_thread_should_end_REC
-    if (prev_node) {
-        getEdgeByNodes(prev_node, curr_node)->setState(EDGE_DISCOVERED);
-        curr_node->setDistance(prev_node->getDistance() + 1);
+AlgorithmSteps Graph::recordHeadlessBFS(EventStream& stream, uint32_t start_id, unsigned int threads_count,
+                                        std::stop_token stop_token) const {
+    const AdjacencyArray& adjacency = stream.getAdjacency();
+    std::vector<int> distances;
+    std::vector<uint32_t> parents;
+    if (!this->searchHeadlessBFS(adjacency, start_id, threads_count, stop_token, distances, parents)) co_return;
+    std::vector<std::vector<uint32_t>> levels;
+    for (uint32_t id = 0; id < adjacency.size(); id++) {
+        if (distances[id] == INT_MAX) continue;
+        if (levels.size() <= (size_t)distances[id]) levels.resize(distances[id] + 1);
+        levels[distances[id]].push_back(id);
     }
 
-    if (curr_node->getState() == NODE_TARGET) {
-        curr_node->setParent(prev_node);
-        this->renderAndWait(window, toolbar, original_view, current_view, font, grid_bounds, wait);
-        return true;
+    for (const std::vector<uint32_t>& level : levels) {
+        for (uint32_t id : level) {
+            stream.setDistance(id, distances[id]);
+            stream.setParent(id, parents[id]);
+            stream.setNodeState(id, NODE_DONE);
+            for (int i = adjacency.rowBegin(id); parents[id] != INVALID_NODE_ID && i < adjacency.rowEnd(id); i++) {
+                if (adjacency.getNeighbor(i) != parents[id]) continue;
+                stream.setEdgeState(i, EDGE_DISCOVERED);
+                break;
+            }
+        }
+        co_yield {};
     }
+}
 
-    curr_node->setState(NODE_DISCOVERED);
-    this->renderAndWait(window, toolbar, original_view, current_view, font, grid_bounds, wait);
 
-    bool found_target = false;
-    for (const std::shared_ptr<Node>& neighbor_node : this->neighbors_list[curr_node->getName()]) {
-        CHECK_IF_algo_thread_should_end_REC
-        if (neighbor_node->getState() != NODE_DISCOVERED && neighbor_node->getState() != NODE_DONE)
-            found_target = dfs(curr_node, neighbor_node, window, toolbar, original_view, current_view, font, grid_bounds, wait);
-        if (found_target) {
-            curr_node->setState(NODE_NEAREST);
-            this->renderAndWait(window, toolbar, original_view, current_view, font, grid_bounds, wait);
-            return true;
+AlgorithmSteps Graph::recordShortestPath(EventStream& stream, uint32_t start_id, uint32_t target_id,
+                                         const std::vector<int>& heuristics) const {
+    const AdjacencyArray& adjacency = stream.getAdjacency();
+    std::vector<int> discovered_edges(adjacency.size(), -1); // adjacency position of the edge each node was reached by
+    bool use_heuristic = !heuristics.empty();
+    // with the heuristic a key can grow by up to twice the edge weight between two settled nodes
+    int max_key_step = use_heuristic ? 2 * adjacency.getMaxWeight() : adjacency.getMaxWeight();
+    std::unique_ptr<PriorityQueue> frontier = createPriorityQueue(this->dijkstra_queue_type, adjacency.size(),
+                                                                     max_key_step);
+    stream.setWeight(start_id, 0);
+    frontier->push(start_id, use_heuristic ? heuristics[start_id] : 0);
+    bool target_found = false;
+    uint32_t current_index = INVALID_NODE_ID;
+
+    // every reachable node is pushed before it's settled, so the search ends once the frontier is empty
+    while (!frontier->empty()) {
+        current_index = frontier->pop();
+        stream.setNodeState(current_index, NODE_DISCOVERED);
+        if (discovered_edges[current_index] != -1) stream.setEdgeState(discovered_edges[current_index], EDGE_DISCOVERED);
+        co_yield {};
+        for (int j = adjacency.rowBegin(current_index); j < adjacency.rowEnd(current_index); j++) {
+            // updating the distance of neighboring nodes
+            uint32_t neighbor_index = adjacency.getNeighbor(j);
+            NodeState neighbor_state = stream.getNodeState(neighbor_index);
+            int new_distance = adjacency.getWeight(j) + stream.getWeight(current_index);
+            if ((neighbor_state == NODE_UNDISCOVERED || neighbor_state == NODE_TARGET) &&
+                new_distance < stream.getWeight(neighbor_index)) {
+                stream.setWeight(neighbor_index, new_distance);
+                stream.setParent(neighbor_index, current_index);
+                discovered_edges[neighbor_index] = j;
+                frontier->push(neighbor_index, use_heuristic ? new_distance + heuristics[neighbor_index] : new_distance);
+            }
+        }
+        if (current_index == target_id) {
+            stream.setNodeState(current_index, NODE_TARGET);
+            target_found = true;
+            break;
         }
+        stream.setNodeState(current_index, NODE_DONE);
+        co_yield {};
     }
 
-    curr_node->setState(NODE_DONE);
-    CHECK_IF_algo_thread_should_end_REC
-    this->renderAndWait(window, toolbar, original_view, current_view, font, grid_bounds, wait);
-    return false;
+    if (target_found) {
+        for (; current_index != INVALID_NODE_ID; current_index = stream.getParent(current_index)) {
+            if (stream.getNodeState(current_index) != NODE_TARGET) stream.setNodeState(current_index, NODE_NEAREST);
+            if (discovered_edges[current_index] != -1) stream.setEdgeState(discovered_edges[current_index], EDGE_NEAREST);
+            co_yield {};
+        }
+    }
 }
 
 
 
-void Graph::runDijkstra(sf::RenderWindow& window, Toolbar& toolbar, sf::View& original_view, sf::View& current_view,
-                        sf::Font* font, sf::FloatRect& grid_bounds, bool wait) {
-    algo_thread_is_running = true;
+void Graph::runHeadlessBFS(unsigned int threads_count) {
+    if (!this->start_node) return;
+    const AdjacencyArray& adjacency = this->getAdjacency();
+    std::vector<int> distances;
+    std::vector<uint32_t> parents;
+    this->searchHeadlessBFS(adjacency, this->start_node->getId(), threads_count, {}, distances, parents);
+    for (uint32_t id = 0; id < adjacency.size(); id++) {
+        const std::shared_ptr<Node>& node = adjacency.getNode(id);
+        if (!node) continue;
+        node->setDistance(distances[id]);
+        node->setParent(parents[id]);
+    }
+}
 
-    if (wait) this->untoggle();
+
+void Graph::runHeadlessDijkstra(unsigned int threads_count) {
     if (!this->start_node) return;
-    this->reset();
-    this->calculate_distances();
-    std::unordered_map<std::shared_ptr<Node>, std::shared_ptr<Edge>> discovered_edges;
-    this->start_node->setWeight(0);
-    bool target_found = false;
-    std::shared_ptr<Node> current_node;
-
-    for (int i = 0; i < nodes_list.size(); i++) {
-        current_node = dijkstraMinDistance();
-        if (current_node->getWeight() < INT_MAX) {
-            current_node->setState(NODE_DISCOVERED);
-            if (discovered_edges.find(current_node) != discovered_edges.end()) {
-                discovered_edges[current_node]->setState(EDGE_DISCOVERED);
-            }
-            CHECK_IF_algo_thread_should_end
-            this->renderAndWait(window, toolbar, original_view, current_view, font, grid_bounds, wait);
-            for (const std::shared_ptr<Node> &neighbor_node: this->neighbors_list[current_node->getName()]) {
-                // updating the distance of neighboring nodes
-                std::shared_ptr<Edge> edge = getEdgeByNodes(current_node, neighbor_node);
-                int new_distance = edge->getLength() + current_node->getWeight() + 60;
-                if ((neighbor_node->getState() == NODE_UNDISCOVERED || neighbor_node->getState() == NODE_TARGET) &&
-                    new_distance < neighbor_node->getWeight()) {
-                    neighbor_node->setWeight(new_distance);
-                    neighbor_node->setParent(current_node);
-                    discovered_edges[neighbor_node] = edge;
-                }
-            }
-            if (current_node == this->target_node) {
-                current_node->setState(NODE_TARGET);
-                target_found = true;
-                break;
+    this->refreshAdjacencyWeights();
+    const AdjacencyArray& adjacency = this->getAdjacency();
+    DeltaStepping sssp(adjacency, threads_count);
+    sssp.run(this->start_node->getId());
+    const std::vector<int>& weights = sssp.getWeights();
+    const std::vector<uint32_t>& parents = sssp.getParents();
+
+#ifdef ALGOVIZ_CHECK_HEADLESS_SEARCH
+    if (!this->matchesSequentialDijkstra(adjacency, this->start_node->getId(), weights))
+        std::cerr << "delta-stepping weights differ from Dijkstra's algorithm" << std::endl;
+#endif
+
+    for (uint32_t id = 0; id < adjacency.size(); id++) {
+        const std::shared_ptr<Node>& node = adjacency.getNode(id);
+        if (!node) continue;
+        node->setWeight(weights[id]);
+        node->setParent(parents[id]);
+    }
+}
+
+
+bool Graph::matchesSequentialDijkstra(const AdjacencyArray& adjacency, uint32_t start_id,
+                                      const std::vector<int>& weights) const {
+    std::vector<int> expected_weights(adjacency.size(), INT_MAX);
+    std::unique_ptr<PriorityQueue> frontier = createPriorityQueue(this->dijkstra_queue_type, adjacency.size(),
+                                                                     adjacency.getMaxWeight());
+    expected_weights[start_id] = 0;
+    frontier->push(start_id, 0);
+    while (!frontier->empty()) {
+        uint32_t current = frontier->pop();
+        for (int j = adjacency.rowBegin(current); j < adjacency.rowEnd(current); j++) {
+            int new_weight = expected_weights[current] + adjacency.getWeight(j);
+            if (new_weight < expected_weights[adjacency.getNeighbor(j)]) {
+                expected_weights[adjacency.getNeighbor(j)] = new_weight;
+                frontier->push(adjacency.getNeighbor(j), new_weight);
             }
-            current_node->setState(NODE_DONE);
-            CHECK_IF_algo_thread_should_end
-            this->renderAndWait(window, toolbar, original_view, current_view, font, grid_bounds, wait);
         }
     }
+    return expected_weights == weights;
+}
 
-    if (target_found) {
-        while (current_node) {
-            CHECK_IF_algo_thread_should_end
-            std::shared_ptr<Edge> nearest_path_edge = this->getEdgeByNodes(current_node, current_node->getParent());
-            if (current_node->getState() != NODE_TARGET) current_node->setState(NODE_NEAREST);
-            if (nearest_path_edge) nearest_path_edge->setState(EDGE_NEAREST);
-            current_node = current_node->getParent();
-            this->renderAndWait(window, toolbar, original_view, current_view, font, grid_bounds, wait);
+
+AlgorithmSteps Graph::recordHeadlessDijkstra(EventStream& stream, uint32_t start_id, unsigned int threads_count,
+                                             std::stop_token stop_token) const {
+    const AdjacencyArray& adjacency = stream.getAdjacency();
+    DeltaStepping sssp(adjacency, threads_count);
+    if (!sssp.run(start_id, stop_token)) co_return;
+    const std::vector<int>& weights = sssp.getWeights();
+    const std::vector<uint32_t>& parents = sssp.getParents();
+#ifdef ALGOVIZ_CHECK_HEADLESS_SEARCH
+    if (!this->matchesSequentialDijkstra(adjacency, start_id, weights))
+        std::cerr << "delta-stepping weights differ from Dijkstra's algorithm" << std::endl;
+#endif
+
+    // the nodes are settled in the order Dijkstra's algorithm would settle them, one a step
+    std::vector<uint32_t> settled;
+    for (uint32_t id = 0; id < adjacency.size(); id++) {
+        if (weights[id] != INT_MAX) settled.push_back(id);
+    }
+    std::stable_sort(settled.begin(), settled.end(), [&](uint32_t first, uint32_t second) {
+        return weights[first] < weights[second];
+    });
+    for (uint32_t id : settled) {
+        stream.setWeight(id, weights[id]);
+        stream.setParent(id, parents[id]);
+        stream.setNodeState(id, NODE_DONE);
+        for (int i = adjacency.rowBegin(id); parents[id] != INVALID_NODE_ID && i < adjacency.rowEnd(id); i++) {
+            if (adjacency.getNeighbor(i) != parents[id]) continue;
+            stream.setEdgeState(i, EDGE_DISCOVERED);
+            break;
         }
+        co_yield {};
     }
-    this->renderAndWait(window, toolbar, original_view, current_view, font, grid_bounds, false, false);
-    if (wait) algo_thread_is_finished = true;
-    algo_thread_is_running = false;
 }
 
 
-void Graph::reset() {
-    if (!this->start_node || (this->start_node->getState() != NODE_DONE &&
-        this->start_node->getState() != NODE_NEAREST && this->start_node->getState() != NODE_DISCOVERED))
-        return;
+AlgorithmSteps Graph::recordBidirectionalBFS(EventStream& stream, uint32_t start_id, uint32_t target_id) const {
+    const AdjacencyArray& adjacency = stream.getAdjacency();
+    // index 0 belongs to the search from the start node, index 1 to the search from the target node
+    const NodeState discovered_states[2] = {NODE_DISCOVERED, NODE_DISCOVERED_BACKWARD};
+    const NodeState done_states[2] = {NODE_DONE, NODE_DONE_BACKWARD};
+    const EdgeState edge_states[2] = {EDGE_DISCOVERED, EDGE_DISCOVERED_BACKWARD};
+    std::vector<int> distances[2] = {std::vector<int>(adjacency.size(), INT_MAX),
+                                     std::vector<int>(adjacency.size(), INT_MAX)};
+    std::vector<uint32_t> parents[2] = {std::vector<uint32_t>(adjacency.size(), INVALID_NODE_ID),
+                                        std::vector<uint32_t>(adjacency.size(), INVALID_NODE_ID)};
+    // adjacency position of the edge each node was reached by
+    std::vector<int> parent_edges[2] = {std::vector<int>(adjacency.size(), -1),
+                                        std::vector<int>(adjacency.size(), -1)};
+    std::vector<uint32_t> frontiers[2] = {{start_id}, {target_id}};
+    std::vector<uint32_t> next_frontier;
+    distances[0][start_id] = 0;
+    distances[1][target_id] = 0;
+    stream.setDistance(start_id, 0);
+    uint32_t forward_end = INVALID_NODE_ID;
+    uint32_t backward_end = INVALID_NODE_ID;
+    int meeting_edge = -1;
+    int path_length = INT_MAX;
+
+    while (path_length == INT_MAX && !frontiers[0].empty() && !frontiers[1].empty()) {
+        int side = (frontiers[0].size() <= frontiers[1].size()) ? 0 : 1;
+        int other = 1 - side;
+        next_frontier.clear();
+        for (uint32_t current_index : frontiers[side]) {
+            if (current_index != target_id) stream.setNodeState(current_index, NODE_CURRENT);
+            co_yield {};
+            for (int i = adjacency.rowBegin(current_index); i < adjacency.rowEnd(current_index); i++) {
+                uint32_t neighbor_index = adjacency.getNeighbor(i);
+                if (distances[side][neighbor_index] != INT_MAX) continue;
+                if (distances[other][neighbor_index] != INT_MAX) {
+                    // the frontiers met, the rest of the level may still hold a shorter path
+                    int length = distances[side][current_index] + 1 + distances[other][neighbor_index];
+                    if (length < path_length) {
+                        path_length = length;
+                        forward_end = (side == 0) ? current_index : neighbor_index;
+                        backward_end = (side == 0) ? neighbor_index : current_index;
+                        meeting_edge = i;
+                    }
+                    continue;
+                }
+                distances[side][neighbor_index] = distances[side][current_index] + 1;
+                parents[side][neighbor_index] = current_index;
+                parent_edges[side][neighbor_index] = i;
+                stream.setDistance(neighbor_index, distances[side][neighbor_index]);
+                stream.setNodeState(neighbor_index, discovered_states[side]);
+                stream.setEdgeState(i, edge_states[side]);
+                next_frontier.push_back(neighbor_index);
+                co_yield {};
+            }
+            if (current_index != target_id) stream.setNodeState(current_index, done_states[side]);
+            co_yield {};
+        }
+        std::swap(frontiers[side], next_frontier);
+    }
+
+    if (path_length != INT_MAX) {
+        AlgorithmSteps path_steps = this->recordBidirectionalPath(stream, distances, parents, parent_edges,
+                                                                  forward_end, backward_end, meeting_edge,
+                                                                  path_length, false, target_id);
+        while (path_steps.next()) co_yield {};
+    }
+}
 
-    for (const auto& node: nodes_list) {
-        if (node.second == this->start_node) {
-            node.second->setState(NODE_START);
+
+AlgorithmSteps Graph::recordBidirectionalDijkstra(EventStream& stream, uint32_t start_id, uint32_t target_id) const {
+    const AdjacencyArray& adjacency = stream.getAdjacency();
+    // index 0 belongs to the search from the start node, index 1 to the search from the target node
+    const NodeState discovered_states[2] = {NODE_DISCOVERED, NODE_DISCOVERED_BACKWARD};
+    const NodeState done_states[2] = {NODE_DONE, NODE_DONE_BACKWARD};
+    const EdgeState edge_states[2] = {EDGE_DISCOVERED, EDGE_DISCOVERED_BACKWARD};
+    std::vector<int> weights[2] = {std::vector<int>(adjacency.size(), INT_MAX),
+                                   std::vector<int>(adjacency.size(), INT_MAX)};
+    std::vector<uint32_t> parents[2] = {std::vector<uint32_t>(adjacency.size(), INVALID_NODE_ID),
+                                        std::vector<uint32_t>(adjacency.size(), INVALID_NODE_ID)};
+    // adjacency position of the edge each node was reached by
+    std::vector<int> discovered_edges[2] = {std::vector<int>(adjacency.size(), -1),
+                                            std::vector<int>(adjacency.size(), -1)};
+    std::vector<bool> is_settled[2] = {std::vector<bool>(adjacency.size(), false),
+                                       std::vector<bool>(adjacency.size(), false)};
+    std::unique_ptr<PriorityQueue> frontiers[2] = {
+            createPriorityQueue(this->dijkstra_queue_type, adjacency.size(), adjacency.getMaxWeight()),
+            createPriorityQueue(this->dijkstra_queue_type, adjacency.size(), adjacency.getMaxWeight())};
+    weights[0][start_id] = 0;
+    weights[1][target_id] = 0;
+    frontiers[0]->push(start_id, 0);
+    frontiers[1]->push(target_id, 0);
+    stream.setWeight(start_id, 0);
+    uint32_t forward_end = INVALID_NODE_ID;
+    uint32_t backward_end = INVALID_NODE_ID;
+    int meeting_edge = -1;
+    int path_weight = INT_MAX;
+
+    while (!frontiers[0]->empty() && !frontiers[1]->empty()) {
+        int forward_key = frontiers[0]->topKey();
+        int backward_key = frontiers[1]->topKey();
+        // a path through nodes that aren't settled yet can't be lighter than the two minimum keys together
+        if (path_weight != INT_MAX && forward_key + backward_key >= path_weight) break;
+        int side = (forward_key <= backward_key) ? 0 : 1;
+        int other = 1 - side;
+        uint32_t current_index = frontiers[side]->pop();
+        is_settled[side][current_index] = true;
+        if (current_index != target_id) {
+            stream.setWeight(current_index, weights[side][current_index]);
+            stream.setNodeState(current_index, discovered_states[side]);
         }
-        else if (node.second == this->target_node) {
-            node.second->setState(NODE_TARGET);
-            node.second->setDistance(INT_MAX);
-            node.second->setWeight(INT_MAX);
+        if (discovered_edges[side][current_index] != -1) {
+            stream.setEdgeState(discovered_edges[side][current_index], edge_states[side]);
         }
-        else {
-            node.second->setState(NODE_UNDISCOVERED);
-            node.second->setDistance(INT_MAX);
-            node.second->setWeight(INT_MAX);
+        co_yield {};
+        for (int j = adjacency.rowBegin(current_index); j < adjacency.rowEnd(current_index); j++) {
+            uint32_t neighbor_index = adjacency.getNeighbor(j);
+            int new_weight = weights[side][current_index] + adjacency.getWeight(j);
+            if (weights[other][neighbor_index] != INT_MAX &&
+                new_weight + weights[other][neighbor_index] < path_weight) {
+                path_weight = new_weight + weights[other][neighbor_index];
+                forward_end = (side == 0) ? current_index : neighbor_index;
+                backward_end = (side == 0) ? neighbor_index : current_index;
+                meeting_edge = j;
+            }
+            if (!is_settled[side][neighbor_index] && new_weight < weights[side][neighbor_index]) {
+                weights[side][neighbor_index] = new_weight;
+                parents[side][neighbor_index] = current_index;
+                discovered_edges[side][neighbor_index] = j;
+                frontiers[side]->push(neighbor_index, new_weight);
+            }
         }
+        if (current_index != target_id) stream.setNodeState(current_index, done_states[side]);
+        co_yield {};
     }
 
-    for (const auto& node: edges_list) {
-        for (const auto& edge: node.second) {
-            edge->setState(EDGE_UNDISCOVERED);
+    if (path_weight != INT_MAX) {
+        AlgorithmSteps path_steps = this->recordBidirectionalPath(stream, weights, parents, discovered_edges,
+                                                                  forward_end, backward_end, meeting_edge,
+                                                                  path_weight, true, target_id);
+        while (path_steps.next()) co_yield {};
+    }
+}
+
+
+AlgorithmSteps Graph::recordBidirectionalPath(EventStream& stream, const std::vector<int> (&labels)[2],
+                                              const std::vector<uint32_t> (&parents)[2],
+                                              const std::vector<int> (&parent_edges)[2], uint32_t forward_end,
+                                              uint32_t backward_end, int meeting_edge, int path_label,
+                                              bool is_weighted, uint32_t target_id) const {
+    std::vector<uint32_t> path;
+    for (uint32_t id = forward_end; id != INVALID_NODE_ID; id = parents[0][id]) path.push_back(id);
+    std::reverse(path.begin(), path.end());
+    size_t forward_size = path.size();
+    uint32_t id = (backward_end == forward_end) ? parents[1][backward_end] : backward_end;
+    for (; id != INVALID_NODE_ID; id = parents[1][id]) path.push_back(id);
+
+    for (size_t i = 0; i < path.size(); i++) {
+        // nodes reached from the target node are labeled with their distance from it, so it's turned around here
+        int label = (i < forward_size) ? labels[0][path[i]] : path_label - labels[1][path[i]];
+        if (is_weighted) stream.setWeight(path[i], label);
+        else stream.setDistance(path[i], label);
+        if (i > 0) {
+            stream.setParent(path[i], path[i - 1]);
+            // the edge into the first node reached from the target node is the one the frontiers met on
+            int path_edge;
+            if (i < forward_size) path_edge = parent_edges[0][path[i]];
+            else if (i > forward_size) path_edge = parent_edges[1][path[i - 1]];
+            else path_edge = (backward_end == forward_end) ? parent_edges[1][forward_end] : meeting_edge;
+            stream.setEdgeState(path_edge, EDGE_NEAREST);
         }
+        if (path[i] != target_id) stream.setNodeState(path[i], NODE_NEAREST);
+        co_yield {};
+    }
+}
+
+
+void Graph::reset() {
+    this->recording = nullptr;
+    // the nodes and edges that weren't set in the new run read as undiscovered, so only the ends are set again
+    this->node_table->startRun();
+    if (this->target_node) this->target_node->setState(NODE_TARGET);
+    if (this->start_node) {
+        this->start_node->setDistance(0);
+        this->start_node->setWeight(0);
+        this->start_node->setState(NODE_START);
     }
 }
 
 //*********************************************Auxiliary Functions******************************************************
 
 
-void Graph::renderAndWait(sf::RenderWindow& window, Toolbar& toolbar, sf::View original_view, sf::View current_view,
-                          sf::Font* font, sf::FloatRect& grid_bounds, bool wait, bool is_mid_run) {
-    if (!wait && is_mid_run) return;
+void Graph::renderFrame(sf::RenderWindow& window, Toolbar& toolbar, sf::View original_view, sf::View current_view,
+                        sf::Font* font, sf::FloatRect& grid_bounds, bool is_mid_run) {
     window_lock.lock();
     window.setActive(true);
     window.clear(BG_COLOR);
@@ -471,64 +994,109 @@ void Graph::renderAndWait(sf::RenderWindow& window, Toolbar& toolbar, sf::View o
     window.display();
     window.setActive(false);
     window_lock.unlock();
-    if (wait) std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_TIME_MS));
 }
 
 
-std::string Graph::generateNodeName() const {
-    return "node_" + std::to_string(this->name_count);
+std::string Graph::generateNodeName(uint32_t id) {
+    return "node_" + std::to_string(id);
 }
 
-bool Graph::checkValidPosition(const Node& node) const {
-    for (auto& pair : this->nodes_list) {
-        if (node.checkBoundsCollision(pair.second) && node.getName() != pair.second->getName()) {
-            return false;
-        }
+
+uint32_t Graph::allocateNodeId() {
+    if (!this->free_ids.empty()) {
+        uint32_t id = this->free_ids.back();
+        this->free_ids.pop_back();
+        return id;
     }
-    return true;
+    this->nodes_list.emplace_back();
+    this->neighbors_list.emplace_back();
+    this->edges_list.emplace_back();
+    return (uint32_t)this->nodes_list.size() - 1;
+}
+
+bool Graph::checkValidPosition(const Node& node) {
+    this->updateMovedNodes();
+    uint32_t node_id = this->node_grid.find(node.getPosition(), false, [&](uint32_t id) {
+        return &node != this->nodes_list[id].get() && node.checkBoundsCollision(this->nodes_list[id]);
+    });
+    return node_id == INVALID_NODE_ID;
 }
 
 
 std::shared_ptr<Edge> Graph::getEdgeByNodes(const std::shared_ptr<Node>& node1, const std::shared_ptr<Node>& node2) {
     if (!node1 || !node2) return nullptr;
-    for (const auto& edge: this->edges_list[node1->getName()]) {
-        if (edge->getSecondNode()->getName() == node2->getName() ||
-            edge->getFirstNode()->getName() == node2->getName())
-            return edge;
-    }
-    return nullptr;
+    auto edge = this->edge_index.find(edgeKey(node1->getId(), node2->getId()));
+    if (edge == this->edge_index.end()) return nullptr;
+    return edge->second;
+}
+
+
+uint64_t Graph::edgeKey(uint32_t node1_id, uint32_t node2_id) const {
+    if (!this->directed && node1_id > node2_id) std::swap(node1_id, node2_id);
+    return ((uint64_t)node1_id << 32) | node2_id;
 }
 
 
 void Graph::calculate_distances() {
     if (!this->start_node) return;
-    std::shared_ptr<Node> current = this->start_node;
-    current->setDistance(0);
-    std::queue<std::shared_ptr<Node>> bfs_q;
-    bfs_q.push(current);
+    const AdjacencyArray& adjacency = this->getAdjacency();
+    this->start_node->setDistance(0);
+    std::queue<uint32_t> bfs_q;
+    bfs_q.push(this->start_node->getId());
     while (!bfs_q.empty()) {
-        current = bfs_q.front();
-        for (const auto& neighbor : this->neighbors_list[current->getName()]) {
+        uint32_t current = bfs_q.front();
+        for (int i = adjacency.rowBegin(current); i < adjacency.rowEnd(current); i++) {
+            const std::shared_ptr<Node>& neighbor = adjacency.getNode(adjacency.getNeighbor(i));
             if (neighbor->getDistance() != INT_MAX) continue;
-            bfs_q.push(neighbor);
-            neighbor->setDistance(current->getDistance() + 1);
+            bfs_q.push(adjacency.getNeighbor(i));
+            neighbor->setDistance(adjacency.getNode(current)->getDistance() + 1);
         }
         bfs_q.pop();
     }
 }
 
 
-std::shared_ptr<Node> Graph::dijkstraMinDistance() const {
-    int min = INT_MAX;
-    std::shared_ptr<Node> min_distance_node;
-    // finding the node with the min distance
-    for (const auto& node: nodes_list) {
-        if (node.second->getState() != NODE_DONE && node.second->getState() != NODE_DISCOVERED && node.second->getWeight() <= min) {
-            min = node.second->getWeight();
-            min_distance_node = node.second;
-        }
+void Graph::updateMovedNodes() {
+    for (uint32_t node_id : this->node_table->takeMovedRows()) {
+        if (node_id >= this->nodes_list.size() || !this->nodes_list[node_id]) continue;
+        this->node_grid.move(node_id, this->nodes_list[node_id]->getPosition());
+        for (const std::shared_ptr<Edge>& edge : this->edges_list[node_id]) this->edge_batch.refreshGeometry(edge.get());
     }
-    return min_distance_node;
+}
+
+
+const AdjacencyArray& Graph::getAdjacency() {
+    // the edge weights are the lengths of the edges, which are only refreshed for the nodes that moved
+    this->updateMovedNodes();
+    if (!this->adjacency_is_valid) {
+        // a new array is built rather than rebuilding this one, which a running algorithm may still hold
+        this->adjacency = std::make_shared<AdjacencyArray>();
+        this->adjacency->build(this->nodes_list, this->edges_list);
+        this->adjacency_is_valid = true;
+    }
+    return *this->adjacency;
+}
+
+
+std::shared_ptr<const AdjacencyArray> Graph::getAdjacencySnapshot() {
+    this->getAdjacency();
+    return this->adjacency;
+}
+
+
+void Graph::refreshAdjacencyWeights() {
+    this->getAdjacency();
+    // the snapshots are only taken with the graph locked, so no new holder can show up while this checks for one
+    if (this->adjacency.use_count() > 1) this->adjacency = std::make_shared<AdjacencyArray>(*this->adjacency);
+    this->adjacency->refreshWeights();
+}
+
+
+int Graph::heuristic(const std::shared_ptr<Node>& node) const {
+    float straight_line = getDistance(node->getPosition().x, node->getPosition().y,
+                                      this->target_node->getPosition().x, this->target_node->getPosition().y);
+    // scaled down a little so that truncating edge lengths to ints can't make the heuristic overestimate
+    return (int)(straight_line * ASTAR_HEURISTIC_SCALE);
 }
 
 
@@ -541,17 +1109,17 @@ void Graph::untoggle() {
 
 std::string Graph::getLiteral() {
     std::string literal = "{";
-    for (const auto& node : this->nodes_list) {
-        std::shared_ptr<Node> current_node = node.second;
+    for (const auto& current_node : this->nodes_list) {
+        if (!current_node) continue;
         std::string node_x = std::to_string((int)current_node->getPosition().x);
         std::string node_y = std::to_string((int)current_node->getPosition().y);
-        literal += node.first + ":<";
+        literal += current_node->getName() + ":<";
         literal += node_x + ",";
         literal += node_y + ">";
     }
     literal += "|";
-    for (const auto& node : this->nodes_list) {
-        for (const auto& edge : this->edges_list[node.first]) {
+    for (const auto& node_edges : this->edges_list) {
+        for (const auto& edge : node_edges) {
             literal += "(" + edge->getFirstNode()->getName() + "," + edge->getSecondNode()->getName() + ")";
         }
     }
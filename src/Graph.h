@@ -11,76 +11,335 @@
 #ifndef ALGOVIZ_GRAPH_H
 #define ALGOVIZ_GRAPH_H
 
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <stop_token>
 #include <string>
+#include <cstdint>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 #include "Node.h"
 #include "Edge.h"
+#include "EdgeBatch.h"
+#include "LabelBatch.h"
+#include "NodeBatch.h"
+#include "NodeGrid.h"
+#include "NodeTable.h"
 #include "Interface.h"
+#include "AdjacencyArray.h"
+#include "PriorityQueue.h"
+#include "ParallelBFS.h"
+#include "DirectionOptimizingBFS.h"
+#include "DeltaStepping.h"
+#include "EventStream.h"
+#include "AlgorithmSteps.h"
 #include <SFML/Graphics.hpp>
 #include <thread>
 
 
 #define BG_COLOR (sf::Color(0,0,50,255))
+#define PLAYBACK_FPS 120 // the most frames a second an animated run renders, the window's frame rate limit
+#define DEFAULT_STEPS_PER_SECOND 10
+#define MAX_STEPS_PER_SECOND 8192 // the fastest limited speed, above it steps are shown as fast as they're recorded
 
 class Graph {
     int nodes_num = 0;
     int edges_num = 0;
-    int name_count = 0;
     bool directed = false;
 
     std::shared_ptr<Node> start_node = nullptr; // pointer to the starting node for pathfinding algorithms
     std::shared_ptr<Node> target_node = nullptr; // pointer to the target node for pathfinding algorithms
     std::shared_ptr<Node> toggled_node = nullptr; // pointer to a node that has been toggled by the user
-    std::unordered_map<std::string, std::shared_ptr<Node>> nodes_list; // map of nodes using their names
-    std::unordered_map<std::string, std::unordered_set<std::shared_ptr<Node>>> neighbors_list; // map of nodes and their neighbor nodes
-    std::unordered_map<std::string, std::unordered_set<std::shared_ptr<Edge>>> edges_list; // map of nodes and their connected edges
+    std::vector<std::shared_ptr<Node>> nodes_list; // nodes indexed by their ids, nullptr for free ids
+    std::shared_ptr<NodeTable> node_table = std::make_shared<NodeTable>(); // the run state of the nodes by id
+    std::vector<std::unordered_set<uint32_t>> neighbors_list; // ids of every node's neighbor nodes, indexed by node id
+    std::vector<std::unordered_set<std::shared_ptr<Edge>>> edges_list; // every node's connected edges, indexed by node id
+    std::vector<uint32_t> free_ids; // ids of removed nodes, reused before new ids are handed out
+    std::unordered_map<uint64_t, std::shared_ptr<Edge>> edge_index; // edges by the key of their endpoint ids
+    NodeGrid node_grid; // the nodes by the cells of the canvas their centers are in, for finding them by position
+    NodeBatch node_batch; // the vertices every node's circle is drawn with
+    LabelBatch label_batch; // the vertices every node's label is drawn with
+    EdgeBatch edge_batch; // the vertices every edge is drawn with, once
+    // CSR snapshot of neighbors_list and edges_list that the algorithms iterate. A running algorithm keeps the
+    // snapshot it started on, so edits build a new one instead of changing it, see refreshAdjacencyWeights
+    std::shared_ptr<AdjacencyArray> adjacency = std::make_shared<AdjacencyArray>();
+    bool adjacency_is_valid = false; // false when the graph was edited since the adjacency array was last built
+    PriorityQueueType dijkstra_queue_type = QUEUE_AUTOMATIC; // the priority queue Dijkstra's algorithm settles nodes with
+    bool bidirectional_search = true; // true if BFS and Dijkstra search from both ends when a target node is set
+    bool headless_search = false; // true if BFS and Dijkstra only show the end of a run when no target node is set
+    unsigned int search_threads = 0; // the threads a headless run searches with, 0 for one per hardware thread
+    std::shared_ptr<EventStream> recording = nullptr; // the steps of the last run, dropped when the graph changes
+
+
+    /** Moves the nodes that moved since it was last called to their new cells of the grid, and refreshes the
+     * geometry and length of their edges.
+     *
+     */
+    void updateMovedNodes();
+
+
+    /** Returns the adjacency array of the graph, rebuilding it first if the graph was edited since it was last built.
+     *
+     * @return reference to the up-to-date adjacency array
+     */
+    const AdjacencyArray& getAdjacency();
+
+
+    /** Returns the adjacency array of the graph like getAdjacency, shared with the caller, who can keep it as an
+     * immutable snapshot of the graph while the graph is edited.
+     *
+     * @return A shared pointer to the up-to-date adjacency array.
+     */
+    std::shared_ptr<const AdjacencyArray> getAdjacencySnapshot();
 
 
-    /** Helper function for rendering the graph and waiting after each object rendering.
+    /** Reloads the weights of the adjacency array from the current edge lengths, after nodes were moved around.
+     *
+     * If a running algorithm still holds the array, the weights are reloaded into a copy of it (copy on write), so
+     * the snapshot the algorithm runs on never changes.
+     */
+    void refreshAdjacencyWeights();
+
+
+    /** Helper function for rendering a frame of the graph.
        *
        * @param window - the window to render the graph on
        * @param toolbar - the toolbar for user interaction
        * @param original_view - the original view of the window before any zooming
        * @param current_view - the current view of the window
        * @param font - pointer to the font used for rendering text
-       * @param wait - flag indicating whether to wait after each object rendering or not
        * @param is_mid_run - flag indicating whether the rendering is part of a pathfinding algorithm. if it's true,
        * the grid and other parts won't get rendered.
        */
-    void renderAndWait(sf::RenderWindow& window, Toolbar& toolbar, sf::View original_view, sf::View current_view,
-                       sf::Font* font, sf::FloatRect& grid_bounds, bool wait = true, bool is_mid_run = true);
+    void renderFrame(sf::RenderWindow& window, Toolbar& toolbar, sf::View original_view, sf::View current_view,
+                     sf::Font* font, sf::FloatRect& grid_bounds, bool is_mid_run = true);
 
 
-    /** Recursive function for performing depth-first search on the graph.
+    /** Helper function that runs Dijkstra's algorithm, or A* when the heuristic is used and a target node is set.
      *
-     * @param prev - the previous node in the DFS traversal
-     * @param start - the source node for the DFS traversal
      * @param window - the window to render the graph on
      * @param toolbar - the toolbar for user interaction
-     * @param original_view - the original view of the window before any zooming
+     * @param original_view - the original view of the window before any zooming or panning
+     * @param current_view - the current view of the window
+     * @param font - pointer to the font used for rendering text
+     * @param wait - flag indicating whether to wait after each object rendering or not
+     * @param use_heuristic - flag indicating whether to order the frontier by the A* heuristic
+     * @param stop_token - cancels the run when a stop is requested
+     * @param graph_guard - the caller's lock on the graph, see runRecorded
+     */
+    void shortestPath(sf::RenderWindow& window, Toolbar& toolbar, sf::View& original_view, sf::View& current_view,
+                      sf::Font* font, sf::FloatRect& grid_bounds, bool wait, bool use_heuristic,
+                      std::stop_token stop_token, std::unique_lock<std::recursive_mutex>& graph_guard);
+
+
+    /** Helper function that runs a recording algorithm and plays back the steps it records.
+     *
+     * The algorithm only touches the event stream and is resumed a step at a time, as the playback needs the steps
+     * it applies to the nodes and edges and renders. Every frame shows as many steps as the playback speed allows,
+     * see steps_per_second in Visualizer.cpp, and frames are rendered no faster than PLAYBACK_FPS. If a stop is
+     * requested on the token, the recording is cancelled. If playback_should_skip is set, the rest of the run is
+     * recorded without waiting and the playback seeks to its end. The stream is kept as the graph's recording once
+     * the run is done, unless the graph was edited meanwhile.
+     *
+     * The algorithm runs on the adjacency snapshot the stream was created with and the playback applies the steps to
+     * the nodes and edges of that snapshot, so edits made while the run plays don't change what it searches. Removed
+     * nodes and edges are no longer rendered, and added ones are left as they are.
+     *
+     * The steps are resumed on the algorithm's task rather than from Visualizer::run. The event loop blocks in
+     * waitEvent, also in the nested loops of pans, drags, button presses and dialogs, and the run keeps playing
+     * during all of them. Stopping the run through its TaskHandle also depends on the task.
+     *
+     * @param record - starts the algorithm to run, which records its steps in the stream it's given
+     * @param window - the window to render the graph on
+     * @param toolbar - the toolbar for user interaction
+     * @param original_view - the original view of the window before any zooming or panning
      * @param current_view - the current view of the window
      * @param font - pointer to the font used for rendering text
-     * @param wait - flag indicating whether to wait after rendering a new state of some object in the graph or not
+     * @param wait - flag indicating whether to play the steps back or only show the end of the run
+     * @param stop_token - cancels the run when a stop is requested
+     * @param graph_guard - the caller's lock on the graph, held while the run was set up. The playback only holds it
+     * while it applies steps and renders, so the graph can be edited in between
+     */
+    void runRecorded(const std::function<AlgorithmSteps(EventStream&)>& record, sf::RenderWindow& window,
+                     Toolbar& toolbar, sf::View& original_view, sf::View& current_view, sf::Font* font,
+                     sf::FloatRect& grid_bounds, bool wait, std::stop_token stop_token,
+                     std::unique_lock<std::recursive_mutex>& graph_guard);
+
+
+    /** Helper function that records Breadth-First Search from the start node.
+     *
+     * @param stream - the stream to record the steps in
+     * @param start_id - the id of the start node
+     * @return The steps of the algorithm, which runs a step at a time as the steps are asked for.
+     */
+    AlgorithmSteps recordBFS(EventStream& stream, uint32_t start_id) const;
+
+
+    /** Helper function that records Depth-First Search from the start node.
+     *
+     * @param stream - the stream to record the steps in
+     * @param start_id - the id of the start node
+     * @return The steps of the algorithm, which runs a step at a time as the steps are asked for.
+     */
+    AlgorithmSteps recordDFS(EventStream& stream, uint32_t start_id) const;
+
+
+    /** Helper function that runs Breadth-First Search headless, on the direction-optimizing engine when it has a
+     * single thread and on the parallel engine otherwise. Both give every node the distance and parent runBFS does.
+     *
+     * @param adjacency - the adjacency array to search
+     * @param start_id - the id of the start node
+     * @param threads_count - the number of threads to search with, or 0 to use one per hardware thread
+     * @param stop_token - stops the search when a stop is requested
+     * @param distances - set to the distance of every node, indexed by node id
+     * @param parents - set to the parent of every node, indexed by node id
+     * @return True if the search ran to the end, false if it was stopped before.
+     */
+    bool searchHeadlessBFS(const AdjacencyArray& adjacency, uint32_t start_id, unsigned int threads_count,
+                           std::stop_token stop_token, std::vector<int>& distances,
+                           std::vector<uint32_t>& parents) const;
+
+
+    /** Helper function that records Breadth-First Search from the start node, run headless by the BFS engines. The
+     * whole search runs when the first step is asked for, and its result is then recorded a level at a time, so
+     * that seeking through the run steps through the levels.
+     *
+     * @param stream - the stream to record the steps in
+     * @param start_id - the id of the start node
+     * @param threads_count - the number of threads to search with, or 0 to use one per hardware thread
+     * @param stop_token - stops the search when a stop is requested, and nothing is recorded then
+     * @return The steps of the algorithm, which runs a step at a time as the steps are asked for.
+     */
+    AlgorithmSteps recordHeadlessBFS(EventStream& stream, uint32_t start_id, unsigned int threads_count,
+                                     std::stop_token stop_token) const;
+
+
+    /** Helper function that records Dijkstra's algorithm from the start node, run headless by the delta-stepping
+     * engine. The whole search runs when the first step is asked for, and the nodes are then recorded as settled one
+     * a step in the order of their weights.
+     *
+     * @param stream - the stream to record the steps in, whose adjacency array holds the current edge weights
+     * @param start_id - the id of the start node
+     * @param threads_count - the number of threads to search with, or 0 to use one per hardware thread
+     * @param stop_token - stops the search when a stop is requested, and nothing is recorded then
+     * @return The steps of the algorithm, which runs a step at a time as the steps are asked for.
+     */
+    AlgorithmSteps recordHeadlessDijkstra(EventStream& stream, uint32_t start_id, unsigned int threads_count,
+                                          std::stop_token stop_token) const;
+
+
+    /** Checks the weights of a headless search against a sequential run of Dijkstra's algorithm. Builds configured
+     * with ALGOVIZ_CHECK_HEADLESS_SEARCH report every headless Dijkstra run whose weights differ.
+     *
+     * @param adjacency - the adjacency array that was searched
+     * @param start_id - the id of the node the search started from
+     * @param weights - the weights the search found, indexed by node id
+     * @return True if Dijkstra's algorithm finds the same weights, false otherwise.
+     */
+    bool matchesSequentialDijkstra(const AdjacencyArray& adjacency, uint32_t start_id,
+                                   const std::vector<int>& weights) const;
+
+
+    /** Helper function that records Dijkstra's algorithm, or A* when heuristics are given.
+     *
+     * @param stream - the stream to record the steps in
+     * @param start_id - the id of the start node
+     * @param target_id - the id of the target node, or INVALID_NODE_ID if no target node is set
+     * @param heuristics - the A* heuristic of every node indexed by node id, or empty to run Dijkstra's algorithm
+     * @return The steps of the algorithm, which runs a step at a time as the steps are asked for.
+     */
+    AlgorithmSteps recordShortestPath(EventStream& stream, uint32_t start_id, uint32_t target_id,
+                                      const std::vector<int>& heuristics) const;
+
+
+    /** Helper function that records BFS from the start node and the target node at the same time.
+     *
+     * Every step expands a whole level of the smaller frontier. When an edge of that level reaches a node of the
+     * other frontier the shortest path is one of the paths found in this level, so the search stops once the level
+     * is done. The graph is undirected, so the backward search walks the same adjacency rows.
      *
-     * @return True if the target node is found during the traversal, false otherwise.
+     * @param stream - the stream to record the steps in
+     * @param start_id - the id of the start node
+     * @param target_id - the id of the target node
+     * @return The steps of the algorithm, which runs a step at a time as the steps are asked for.
      */
-    bool dfs(const std::shared_ptr<Node>& prev, const std::shared_ptr<Node>& start, sf::RenderWindow& window, Toolbar& toolbar, sf::View& original_view, sf::View& current_view, sf::Font* font, sf::FloatRect& grid_bounds, bool wait = false);
+    AlgorithmSteps recordBidirectionalBFS(EventStream& stream, uint32_t start_id, uint32_t target_id) const;
 
 
-    /** Helper function for finding the node with the minimum distance in Dijkstra's algorithm.
-      *
-      * @return pointer to the node with the minimum distance
-      */
-    std::shared_ptr<Node> dijkstraMinDistance() const;
+    /** Helper function that records Dijkstra's algorithm from the start node and the target node at the same time.
+     *
+     * Every step settles a node from the frontier with the smaller minimum key, and every scanned edge that reaches
+     * a node labeled by the other search is a candidate path. The search stops once the minimum keys of both
+     * frontiers add up to at least the weight of the best candidate, since no shorter path can be found after that.
+     *
+     * @param stream - the stream to record the steps in
+     * @param start_id - the id of the start node
+     * @param target_id - the id of the target node
+     * @return The steps of the algorithm, which runs a step at a time as the steps are asked for.
+     */
+    AlgorithmSteps recordBidirectionalDijkstra(EventStream& stream, uint32_t start_id, uint32_t target_id) const;
+
+
+    /** Helper function for recording the path found by a bidirectional search, from the start node to the target node.
+     *
+     * The nodes of the path get their distance from the start node, or their weight in a weighted search.
+     *
+     * @param stream - the stream to record the steps in
+     * @param labels - the distance of every node from the start node and from the target node, indexed by node id
+     * @param parents - the id of the node every node was reached from by each search, indexed by node id
+     * @param parent_edges - the adjacency position of the edge every node was reached by in each search
+     * @param forward_end - the id of the last node of the path that was reached from the start node
+     * @param backward_end - the id of the first node of the path that was reached from the target node
+     * @param meeting_edge - the adjacency position of the edge between forward_end and backward_end
+     * @param path_label - the distance or weight of the whole path
+     * @param is_weighted - flag indicating whether the labels are weights or distances
+     * @param target_id - the id of the target node
+     * @return The steps of the algorithm, which runs a step at a time as the steps are asked for.
+     */
+    AlgorithmSteps recordBidirectionalPath(EventStream& stream, const std::vector<int> (&labels)[2],
+                                           const std::vector<uint32_t> (&parents)[2],
+                                           const std::vector<int> (&parent_edges)[2], uint32_t forward_end,
+                                           uint32_t backward_end, int meeting_edge, int path_label, bool is_weighted,
+                                           uint32_t target_id) const;
+
+
+    /** Helper function for estimating the weight of the shortest path from a node to the target node for A*.
+     *
+     * Edge weights are the distances between the centers of the nodes, so the straight-line distance to the target
+     * never overestimates the remaining path weight.
+     *
+     * @param node - the node to estimate the remaining path weight from
+     * @return the estimated weight of the path to the target node
+     */
+    int heuristic(const std::shared_ptr<Node>& node) const;
 
 
-    /** Helper function for generating a unique node name.
+    /** Helper function for generating the display name of a node from its id.
      *
+     * @param id - the id of the node
      * @return a unique node name string
      */
-    std::string generateNodeName() const;
+    static std::string generateNodeName(uint32_t id);
+
+
+    /** Helper function for generating the edge index key of a pair of nodes.
+     *
+     * In an undirected graph the key doesn't depend on the order of the nodes.
+     *
+     * @param node1_id - the id of the first node
+     * @param node2_id - the id of the second node
+     * @return the key of the edge between the nodes in edge_index
+     */
+    uint64_t edgeKey(uint32_t node1_id, uint32_t node2_id) const;
+
+
+    /** Helper function for handing out a node id, reusing the id of a removed node if there is one.
+     *
+     * @return a free node id, with its entries in the id-indexed lists allocated
+     */
+    uint32_t allocateNodeId();
 
 
     /** Helper function for calculating the distances between the start node and all other nodes in the graph
@@ -92,13 +351,34 @@ class Graph {
     explicit Graph() = default;
 
 
-    /** Copy constructor for the Graph class.
+    /** Copy constructor for the Graph class. The copy has nodes and edges of its own, with the same ids, positions
+     * and states, and the same start node, target node and search options.
      *
      * @param other - the Graph object to copy from
      */
     Graph(const Graph& other);
 
 
+    /** Default move constructor.
+     *
+     */
+    Graph(Graph&& other) = default;
+
+
+    /** Replaces the graph with a copy of another one, see the copy constructor.
+     *
+     * @param other - the Graph object to copy from
+     * @return Reference to this graph.
+     */
+    Graph& operator=(const Graph& other);
+
+
+    /** Default move assignment.
+     *
+     */
+    Graph& operator=(Graph&& other) = default;
+
+
     /** Default destructor
      *
      */
@@ -119,6 +399,58 @@ class Graph {
     void setTargetNode(const std::shared_ptr<Node>& target_node);
 
 
+    /** Sets the type of priority queue used by Dijkstra's algorithm.
+     *
+     * @param queue_type - the type of the priority queue
+     */
+    void setDijkstraQueue(PriorityQueueType queue_type);
+
+
+    /** Returns the type of priority queue used by Dijkstra's algorithm.
+     *
+     * @return The type of the priority queue.
+     */
+    PriorityQueueType getDijkstraQueue() const;
+
+
+    /** Sets whether BFS and Dijkstra's algorithm search from the start node and the target node at the same time
+     * when a target node is set.
+     *
+     * @param is_bidirectional - true to search from both ends, false to search from the start node only
+     */
+    void setBidirectionalSearch(bool is_bidirectional);
+
+
+    /** Checks whether BFS and Dijkstra's algorithm search from both ends when a target node is set.
+     *
+     * @return True if they search from both ends, false if they search from the start node only.
+     */
+    bool isBidirectionalSearch() const;
+
+
+    /** Sets whether BFS and Dijkstra's algorithm run headless when no target node is set. A headless run searches
+     * on the parallel engines and only shows its end, which can still be stepped through like any other run.
+     *
+     * @param is_headless - true to run headless, false to play the search back a step at a time
+     * @param threads_count - the number of threads a headless run searches with, or 0 to use one per hardware thread
+     */
+    void setHeadlessSearch(bool is_headless, unsigned int threads_count = 0);
+
+
+    /** Checks whether BFS and Dijkstra's algorithm run headless when no target node is set.
+     *
+     * @return True if they run headless, false if they play the search back a step at a time.
+     */
+    bool isHeadlessSearch() const;
+
+
+    /** Returns the number of threads a headless run searches with.
+     *
+     * @return The number of threads, or 0 for one per hardware thread.
+     */
+    unsigned int getSearchThreads() const;
+
+
     /** Renders the graph on a specified window using the specified font for texts.
      *
      * @param target - the window to render the graph on
@@ -127,21 +459,21 @@ class Graph {
     void render(sf::RenderWindow& target, sf::Font* font);
 
 
-    /** Adds a node to the graph.
+    /** Adds a node to the graph, assigning it a new id and a matching name.
      *
      * @param node - the node to add
      */
     void addNode(std::shared_ptr<Node>& node);
 
 
-    /** Removes a node from the graph by its name.
+    /** Removes a node from the graph by its id.
      *
-     * @param node_name - the name of the node to remove
+     * @param node_id - the id of the node to remove
      */
-    void removeNode(const std::string& node_name);
+    void removeNode(uint32_t node_id);
 
 
-    /** Adds an edge to the graph.
+    /** Adds an edge to the graph, unless it's already in it or one of its nodes isn't.
      *
      * @param edge - the edge to add
      */
@@ -172,6 +504,10 @@ class Graph {
 
 
     /** Runs Breadth-First Search on the graph.
+     *
+     * When a target node is set the search grows from both ends, see setBidirectionalSearch. When no target node is
+     * set and nothing is rendered until the end, or headless runs are on, the search runs on the headless BFS
+     * engines, see setHeadlessSearch.
      *
      * @param window - the window to render the graph on
      * @param toolbar - the toolbar for user interaction
@@ -180,11 +516,16 @@ class Graph {
      * @param font - pointer to the font used for rendering text
      * @param wait - flag indicating whether to wait after each object rendering or not. set to false when
      * called by END-operation.
+     * @param stop_token - cancels the run when a stop is requested, see TaskScheduler
      */
-    void runBFS(sf::RenderWindow& window, Toolbar& toolbar, sf::View& original_view, sf::View& current_view, sf::Font* font, sf::FloatRect& grid_bounds, bool wait = false);
+    void runBFS(sf::RenderWindow& window, Toolbar& toolbar, sf::View& original_view, sf::View& current_view, sf::Font* font, sf::FloatRect& grid_bounds, bool wait = false,
+                std::stop_token stop_token = {});
 
 
     /** Runs Depth-First Search on the graph.
+     *
+     * The search keeps its own stack instead of recursing, so the depth of the graph isn't limited by the size of
+     * the thread's stack.
      *
      * @param window - the window to render the graph on
      * @param toolbar - the toolbar for user interaction
@@ -193,11 +534,34 @@ class Graph {
      * @param font - pointer to the font used for rendering text
      * @param wait - flag indicating whether to wait after each object rendering or not. set to false when
      * called by END-operation.
+     * @param stop_token - cancels the run when a stop is requested, see TaskScheduler
      */
-    void runDFS(sf::RenderWindow& window, Toolbar& toolbar, sf::View& original_view, sf::View& current_view, sf::Font* font, sf::FloatRect& grid_bounds, bool wait = false);
+    void runDFS(sf::RenderWindow& window, Toolbar& toolbar, sf::View& original_view, sf::View& current_view, sf::Font* font, sf::FloatRect& grid_bounds, bool wait = false,
+                std::stop_token stop_token = {});
 
 
     /** Runs Dijkstra's algorithm on the graph.
+     *
+     * When a target node is set the search grows from both ends, see setBidirectionalSearch. When no target node is
+     * set and nothing is rendered until the end, or headless runs are on, the search runs on the delta-stepping
+     * engine, see setHeadlessSearch.
+     *
+     * @param window - the window to render the graph on
+     * @param toolbar - the toolbar for user interaction
+     * @param original_view - the original view of the window before any zooming or panning
+     * @param current_view - the current view of the window
+     * @param font - pointer to the font used for rendering text
+     * @param wait - flag indicating whether to wait after each object rendering or not. set to false when
+     * called by END-operation.
+     * @param stop_token - cancels the run when a stop is requested, see TaskScheduler
+     */
+    void runDijkstra(sf::RenderWindow& window, Toolbar& toolbar, sf::View& original_view, sf::View& current_view, sf::Font* font, sf::FloatRect& grid_bounds, bool wait = false,
+                     std::stop_token stop_token = {});
+
+
+    /** Runs A* search on the graph, using the straight-line distance to the target node as the heuristic.
+     *
+     * Visualized the same way as Dijkstra's algorithm, which it falls back to when no target node is set.
      *
      * @param window - the window to render the graph on
      * @param toolbar - the toolbar for user interaction
@@ -206,11 +570,57 @@ class Graph {
      * @param font - pointer to the font used for rendering text
      * @param wait - flag indicating whether to wait after each object rendering or not. set to false when
      * called by END-operation.
+     * @param stop_token - cancels the run when a stop is requested, see TaskScheduler
+     */
+    void runAStar(sf::RenderWindow& window, Toolbar& toolbar, sf::View& original_view, sf::View& current_view, sf::Font* font, sf::FloatRect& grid_bounds, bool wait = false,
+                  std::stop_token stop_token = {});
+
+
+    /** Runs Breadth-First Search from the start node without rendering.
+     *
+     * Every node gets the same distance and parent runBFS gives it when no target node is set, see ParallelBFS and
+     * DirectionOptimizingBFS. Node and edge states aren't changed.
+     *
+     * @param threads_count - the number of threads to search with, or 0 to use one per hardware thread
+     */
+    void runHeadlessBFS(unsigned int threads_count = 0);
+
+
+    /** Finds the shortest paths from the start node without rendering, using the parallel delta-stepping engine.
+     *
+     * Every node gets the same weight runDijkstra gives it when no target node is set, and the node before it on a
+     * shortest path as its parent. Node and edge states aren't changed. Builds configured with
+     * ALGOVIZ_CHECK_HEADLESS_SEARCH check the weights against a sequential run of Dijkstra's algorithm.
+     *
+     * @param threads_count - the number of threads to search with, or 0 to use one per hardware thread
+     */
+    void runHeadlessDijkstra(unsigned int threads_count = 0);
+
+
+    /** Shows the nodes and edges as they were after a number of steps of the last run.
+     *
+     * @param step - the number of steps to show, clamped to the length of the run
+     * @return False if there's no recorded run to seek in, true otherwise.
+     */
+    bool seekRecording(size_t step);
+
+
+    /** Returns the number of steps of the last run that are shown.
+     *
+     * @return The current step of the recording, or 0 if there's no recorded run.
+     */
+    size_t getRecordingStep() const;
+
+
+    /** Returns the number of steps in the last run.
+     *
+     * @return The length of the recording, or 0 if there's no recorded run.
      */
-    void runDijkstra(sf::RenderWindow& window, Toolbar& toolbar, sf::View& original_view, sf::View& current_view, sf::Font* font, sf::FloatRect& grid_bounds, bool wait = false);
+    size_t getRecordingLength() const;
 
 
-    /** Resets the graph, clearing all nodes and edges.
+    /** Resets the state the last run left on the nodes and edges, in constant time, by starting a new run of the
+     * node table.
      *
      */
     void reset();
@@ -235,7 +645,7 @@ class Graph {
      *
      * @return true if the position is valid, false otherwise
      */
-    bool checkValidPosition(const Node& node) const;
+    bool checkValidPosition(const Node& node);
 
 
     /** Returns a const reference to the source node of the graph.
@@ -272,14 +682,13 @@ class Graph {
     std::shared_ptr<Edge> getEdgeByNodes(const std::shared_ptr<Node>& node1, const std::shared_ptr<Node>& node2);
 
 
-    /** Adds a new node to the graph with the given position and font for rendering text.
+    /** Adds a new node to the graph with the given position.
      *
      * @param pos_x - the x-coordinate of the position to add the new node
      * @param pos_y - the y-coordinate of the position to add the new node
-     * @param text_font - pointer to the font used for rendering text
      * @return pointer to the newly added node
      */
-    std::shared_ptr<Node> addNode(float pos_x, float pos_y, sf::Font* text_font);
+    std::shared_ptr<Node> addNode(float pos_x, float pos_y);
 
 
     /** Returns a pointer to the node in the graph that collides with the given node.
@@ -287,7 +696,7 @@ class Graph {
      * @param moving_node - pointer to the node to check for collisions with other nodes
      * @return pointer to the colliding node, or nullptr if none exists
      */
-    std::shared_ptr<Node> getCollidedNode(const std::shared_ptr<Node>& moving_node) const;
+    std::shared_ptr<Node> getCollidedNode(const std::shared_ptr<Node>& moving_node);
 
 
 
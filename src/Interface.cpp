@@ -7,7 +7,6 @@
 #include <filesystem>
 
 
-extern bool algo_thread_is_running;
 
 
 //--------------------------------------------Button methods------------------------------------------------------------
@@ -73,7 +72,7 @@ void Button::render(sf::RenderTarget& target) {
 
 Toolbar::Toolbar() {
     std::vector<ButtonId> id_list = {CURSOR, ADD_NODE, ADD_EDGE, ERASE, CHANGE_START_NODE, CHOOSE_TARGET_NODE,
-                                     REMOVE_TARGET_NODE, RUN_BFS, RUN_DFS, RUN_DIJKSTRA, END, RESET, CLEAR_WINDOW,
+                                     REMOVE_TARGET_NODE, RUN_BFS, RUN_DFS, RUN_DIJKSTRA, RUN_ASTAR, END, RESET, CLEAR_WINDOW,
                                      SAVE_TO_FILE, LOAD_FROM_FILE};
     this->buttons.push_back(std::make_shared<Button>(32.5, 15, 30, 30, "./images/cursor.png", CURSOR));
     this->buttons.push_back(std::make_shared<Button>(35, 60, 30, 30, "./images/add_node.png", ADD_NODE));
@@ -88,13 +87,14 @@ Toolbar::Toolbar() {
     this->buttons.push_back(std::make_shared<Button>(25, 360, 50, 30, "./images/run_bfs.png", RUN_BFS));
     this->buttons.push_back(std::make_shared<Button>(25, 410, 50, 30, "./images/run_dfs.png", RUN_DFS));
     this->buttons.push_back(std::make_shared<Button>(15, 460, 70, 30, "./images/run_dijkstra.png", RUN_DIJKSTRA));
-    this->buttons.push_back(std::make_shared<Button>(35, 510, 30, 30, "./images/end.png", END));
-    this->buttons.push_back(std::make_shared<Button>(35, 560, 30, 30, "./images/reset.png", RESET));
-    this->buttons.push_back(std::make_shared<Button>(35, 610, 30, 30, "./images/clear_window.png", CLEAR_WINDOW));
-    this->buttons.push_back(std::make_shared<Button>(30, 655, 45, 45, "./images/save_to_file.png", SAVE_TO_FILE));
-    this->buttons.push_back(std::make_shared<Button>(30, 705, 45, 45, "./images/load_from_file.png", LOAD_FROM_FILE));
+    this->buttons.push_back(std::make_shared<Button>(25, 510, 50, 30, "./images/run_astar.png", RUN_ASTAR));
+    this->buttons.push_back(std::make_shared<Button>(35, 560, 30, 30, "./images/end.png", END));
+    this->buttons.push_back(std::make_shared<Button>(35, 610, 30, 30, "./images/reset.png", RESET));
+    this->buttons.push_back(std::make_shared<Button>(35, 660, 30, 30, "./images/clear_window.png", CLEAR_WINDOW));
+    this->buttons.push_back(std::make_shared<Button>(30, 705, 45, 45, "./images/save_to_file.png", SAVE_TO_FILE));
+    this->buttons.push_back(std::make_shared<Button>(30, 755, 45, 45, "./images/load_from_file.png", LOAD_FROM_FILE));
     this->rectangle.setPosition(10, 10);
-    this->rectangle.setSize({80, 745});
+    this->rectangle.setSize({80, 795});
     this->rectangle.setFillColor(TOOLBAR_COLOR);
     this->rectangle.setOutlineColor(sf::Color::White);
     this->rectangle.setOutlineThickness(2.f);
@@ -128,9 +128,9 @@ bool Toolbar::updateActiveButton(const sf::Vector2f& mousePosWindow) {
 }
 
 void Toolbar::render(sf::RenderWindow& window, bool is_mid_run) {
-    std::vector<ButtonId> not_to_render_while_running = {CURSOR, ADD_NODE, ADD_EDGE, ERASE, CHANGE_START_NODE,
-                                                         CHOOSE_TARGET_NODE, REMOVE_TARGET_NODE, RUN_BFS, RUN_DFS,
-                                                         RUN_DIJKSTRA, SAVE_TO_FILE, LOAD_FROM_FILE};
+    // the graph can be edited while an algorithm runs, but only one algorithm runs at a time
+    std::vector<ButtonId> not_to_render_while_running = {RUN_BFS, RUN_DFS, RUN_DIJKSTRA, RUN_ASTAR, SAVE_TO_FILE,
+                                                         LOAD_FROM_FILE};
     window.draw(this->rectangle);
 
     for (const auto & horizontal_separator : this->horizontal_separators) {
@@ -269,7 +269,7 @@ void SavedGraphsList::addGraph(const std::string& graph_name) {
     sf::RectangleShape frame;
     frame.setSize(sf::Vector2f(150, 50));
     frame.setFillColor(TOOLBAR_COLOR);
-    frame.setPosition(92, (float)(695 - this->saved_graphs_num * 50));
+    frame.setPosition(92, (float)(745 - this->saved_graphs_num * 50));
     frame.setOutlineThickness(1);
     frame.setOutlineColor(sf::Color::White);
     this->saved_graphs[graph_name] = std::make_shared<sf::RectangleShape>(frame);
@@ -282,7 +282,7 @@ void SavedGraphsList::deleteGraph(const std::string& graph_name) {
     this->saved_graphs_num--;
     int i = 0;
     for (const auto& saved_graph : this->saved_graphs) {
-        saved_graph.second->setPosition(92, (float)(795 - 50*i));
+        saved_graph.second->setPosition(92, (float)(845 - 50*i));
     }
 }
 
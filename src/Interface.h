@@ -106,6 +106,7 @@ enum ButtonId {
     REMOVE_TARGET_NODE,
     RUN_BFS, RUN_DFS,
     RUN_DIJKSTRA,
+    RUN_ASTAR,
     END,
     RESET,
     CLEAR_WINDOW,
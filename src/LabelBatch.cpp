@@ -0,0 +1,80 @@
+#include "LabelBatch.h"
+#include <algorithm>
+#include <climits>
+#include <string>
+
+
+bool LabelBatch::showsLabel(NodeState state) {
+    return state == NODE_DONE || state == NODE_DISCOVERED || state == NODE_NEAREST || state == NODE_TARGET ||
+           state == NODE_CURRENT || state == NODE_DISCOVERED_BACKWARD || state == NODE_DONE_BACKWARD;
+}
+
+
+std::vector<sf::Vertex> LabelBatch::layOut(int value) const {
+    std::string text;
+    sf::Vector2f origin(21, 9);
+    unsigned int character_size = LABEL_CHARACTER_SIZE;
+    if (value == INT_MAX) { // debugging purposes (correct run should never have to print inf
+        text = "inf";
+    }
+    else {
+        text = std::to_string(value);
+        origin += sf::Vector2f(-((float)text.size() - 1) * 5, (float)text.size() - 1);
+        character_size = (unsigned int)std::max<long long>((LABEL_CHARACTER_SIZE + 1) - (long long)text.size() * 2, 1);
+    }
+    float scale = (float)character_size / LABEL_CHARACTER_SIZE;
+
+    // the same layout sf::Text does, with the baseline a character size below the origin
+    std::vector<sf::Vertex> run;
+    float x = 0;
+    float y = LABEL_CHARACTER_SIZE;
+    sf::Uint32 previous = 0;
+    for (char c : text) {
+        sf::Uint32 current = (sf::Uint32)(unsigned char)c;
+        x += this->font->getKerning(previous, current, LABEL_CHARACTER_SIZE);
+        previous = current;
+        const sf::Glyph& glyph = this->font->getGlyph(current, LABEL_CHARACTER_SIZE, false);
+        float padding = 1;
+        float left = x + glyph.bounds.left - padding;
+        float top = y + glyph.bounds.top - padding;
+        float right = x + glyph.bounds.left + glyph.bounds.width + padding;
+        float bottom = y + glyph.bounds.top + glyph.bounds.height + padding;
+        float u1 = (float)glyph.textureRect.left - padding;
+        float v1 = (float)glyph.textureRect.top - padding;
+        float u2 = (float)(glyph.textureRect.left + glyph.textureRect.width) + padding;
+        float v2 = (float)(glyph.textureRect.top + glyph.textureRect.height) + padding;
+        run.emplace_back(origin + sf::Vector2f(left, top) * scale, sf::Color::White, sf::Vector2f(u1, v1));
+        run.emplace_back(origin + sf::Vector2f(right, top) * scale, sf::Color::White, sf::Vector2f(u2, v1));
+        run.emplace_back(origin + sf::Vector2f(right, bottom) * scale, sf::Color::White, sf::Vector2f(u2, v2));
+        run.emplace_back(origin + sf::Vector2f(left, bottom) * scale, sf::Color::White, sf::Vector2f(u1, v2));
+        x += glyph.advance;
+    }
+    return run;
+}
+
+
+void LabelBatch::render(sf::RenderTarget& target, const sf::Font& font,
+                        const std::vector<std::shared_ptr<Node>>& nodes_list, bool shows_weights) {
+    if (this->font != &font || this->runs.size() >= LABEL_CACHE_SIZE) {
+        this->runs.clear();
+        this->font = &font;
+    }
+    this->labels.clear();
+    for (const std::shared_ptr<Node>& node : nodes_list) {
+        if (!node) continue;
+        NodeState state = node->getState();
+        if (!showsLabel(state)) continue;
+        int value = shows_weights ? node->getWeight() : node->getDistance();
+        // If no algorithm ran, target node will have inf distance and should not print a value.
+        if (state == NODE_TARGET && (value == INT_MAX || value == 0)) continue;
+        auto found = this->runs.find(value);
+        if (found == this->runs.end()) found = this->runs.emplace(value, this->layOut(value)).first;
+        sf::Vector2f position = node->getPosition();
+        for (const sf::Vertex& vertex : found->second) {
+            this->labels.append(sf::Vertex(vertex.position + position, vertex.color, vertex.texCoords));
+        }
+    }
+    if (this->labels.getVertexCount() == 0) return;
+    sf::RenderStates states(&font.getTexture(LABEL_CHARACTER_SIZE));
+    target.draw(this->labels, states);
+}
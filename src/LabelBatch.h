@@ -0,0 +1,74 @@
+/**
+ * This code represents the distance and weight labels of all the nodes of a graph, kept in a vertex array so that
+ * they are drawn with a single draw call against the font's texture instead of one sf::Text per node.
+ *
+ * The glyph quads of a label are laid out once for every value that is shown, relative to the node's position, and
+ * kept in a cache by that value. Drawing the labels only copies the cached quads of every labelled node into the
+ * array, moved to the node's position, so no string is built and no text is laid out again from frame to frame.
+ */
+
+#ifndef ALGOVIZ_LABELBATCH_H
+#define ALGOVIZ_LABELBATCH_H
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "Node.h"
+#include "SFML/Graphics.hpp"
+
+#define LABEL_CHARACTER_SIZE 30 // the character size the glyphs of every label are taken from the font with
+#define LABEL_CACHE_SIZE 4096 // the number of laid out values after which the cache is emptied
+
+
+class LabelBatch {
+    std::unordered_map<int, std::vector<sf::Vertex>> runs; // value -> the glyph quads of its label
+    const sf::Font* font = nullptr; // the font the cached runs were laid out with
+    sf::VertexArray labels = sf::VertexArray(sf::Quads); // 4 vertices for every glyph of every shown label
+
+
+    /** Checks whether a node in the given state shows a label.
+     *
+     * @param state - the state of the node
+     * @return True if the node's label is drawn, false otherwise.
+     */
+    static bool showsLabel(NodeState state);
+
+
+    /** Lays out the glyph quads of the label of a value, relative to the position of the node it's shown on.
+     *
+     * Longer values are drawn smaller and further left so that they stay on the node. The glyphs of every size are
+     * scaled from the ones of LABEL_CHARACTER_SIZE, so that all of them are on the same texture of the font.
+     *
+     * @param value - the distance or weight to lay out, INT_MAX is shown as "inf"
+     * @return The 4 vertices of every glyph of the label.
+     */
+    std::vector<sf::Vertex> layOut(int value) const;
+
+public:
+
+    /** Constructs a batch with no labels.
+     *
+     */
+    LabelBatch() = default;
+
+
+    /** Draws the labels of all the nodes whose state shows one at once, laying out the values that aren't cached yet.
+     *
+     * @param target - the render target to draw the labels on
+     * @param font - the font of the labels
+     * @param nodes_list - the graph's nodes indexed by their ids, nullptr for free ids
+     * @param shows_weights - true to show the weights of the nodes, false to show their distances
+     */
+    void render(sf::RenderTarget& target, const sf::Font& font, const std::vector<std::shared_ptr<Node>>& nodes_list,
+                bool shows_weights);
+
+
+    /** Default destructor.
+     *
+     */
+    ~LabelBatch() = default;
+
+};
+
+
+#endif //ALGOVIZ_LABELBATCH_H
@@ -1,4 +1,5 @@
 #include "Node.h"
+#include "NodeTable.h"
 #include <cmath>
 #include <utility>
 #include "utils.h"
@@ -7,145 +8,128 @@
 #define RADIUS 30
 
 
-Node::Node(std::string name, float pos_x, float pos_y, sf::Font* text_font): name(std::move(name)), font(text_font) {
-    this->shape.setRadius(RADIUS);
-    this->shape.setOutlineColor(NODE_OUTLINE_COLOR);
-    this->shape.setPosition(pos_x, pos_y);
+Node::Node(const std::string& name, float pos_x, float pos_y): table(std::make_shared<NodeTable>(1)) {
+    this->table->setName(0, name);
+    this->table->setPosition(0, {pos_x, pos_y});
 }
 
-sf::CircleShape Node::getShape() const {
-    return this->shape;
-}
-
-void Node::render(sf::RenderWindow& window, const std::string& to_print) {
-    window.draw(this->shape);
-    if (this->state != NODE_DONE && this->state != NODE_DISCOVERED && this->state != NODE_NEAREST && this->state != NODE_TARGET && this->state != NODE_CURRENT) return;
-    // If no algorithm ran, target node will have inf distance and should not print a value.
-    if (this->state == NODE_TARGET && (to_print == std::to_string(INT_MAX) || to_print == std::to_string(0))) return;
-    sf::Text t;
-    t.setFont(*font);
-    t.setPosition(this->getPosition().x+21, this->getPosition().y+9);
-    t.setFillColor(sf::Color::White);
-    t.setCharacterSize(30);
-    if (to_print == std::to_string(INT_MAX)) { // debugging purposes (correct run should never have to print inf
-        t.setString("inf");
-    }
-    else {
-        t.setPosition(t.getPosition().x - ((float)to_print.size()-1)*5, t.getPosition().y + ((float)to_print.size()-1));
-        t.setCharacterSize(std::max<long long>((t.getCharacterSize()+1) - to_print.size()*2, 1));
-        t.setString(to_print);
+sf::Color Node::getStateColor(NodeState state) {
+    switch (state) {
+        case NODE_START: return START_NODE_COLOR;
+        case NODE_TARGET: return TARGET_NODE_COLOR;
+        case NODE_NEAREST: return NEAREST_NODE_COLOR;
+        case NODE_CURRENT: return CURRENT_NODE_COLOR;
+        case NODE_DISCOVERED: return DISCOVERED_NODE_COLOR;
+        case NODE_DONE: return DONE_NODE_COLOR;
+        case NODE_DISCOVERED_BACKWARD: return DISCOVERED_BACKWARD_NODE_COLOR;
+        case NODE_DONE_BACKWARD: return DONE_BACKWARD_NODE_COLOR;
+        default: return UNDISCOVERED_NODE_COLOR;
     }
-    window.draw(t);
 }
 
 std::string Node::getName() const {
-    return this->name;
+    return this->table->getName(this->row);
+}
+
+void Node::setName(const std::string& new_name) {
+    this->table->setName(this->row, new_name);
+}
+
+uint32_t Node::getId() const {
+    return this->id;
+}
+
+void Node::attach(const std::shared_ptr<NodeTable>& graph_table, uint32_t new_id) {
+    graph_table->copyRow(*this->table, this->row, new_id);
+    this->table = graph_table;
+    this->row = new_id;
+    this->id = new_id;
+}
+
+void Node::detach() {
+    std::shared_ptr<NodeTable> own_table = std::make_shared<NodeTable>(1);
+    own_table->copyRow(*this->table, this->row, 0);
+    this->table = own_table;
+    this->row = 0;
+    // the id may be handed out to another node, which this one must not be taken for
+    this->id = INVALID_NODE_ID;
+}
+
+uint32_t Node::getRun() const {
+    return this->table->getRun();
 }
 
 bool Node::checkBoundsCollision(const std::shared_ptr<Node>& node) const {
-    sf::Vector2<float> first_center = this->getShape().getPosition();
-    sf::Vector2<float> second_center = node->getShape().getPosition();
+    sf::Vector2<float> first_center = this->getPosition();
+    sf::Vector2<float> second_center = node->getPosition();
     return std::abs(pow(first_center.x - second_center.x, 2) + pow(first_center.y - second_center.y, 2)) < pow(2 * RADIUS, 2);
 }
 
 void Node::setDistance(int updated_distance) {
-    this->distance = updated_distance;
+    this->table->setDistance(this->row, updated_distance);
 }
 
 int Node::getDistance() const {
-    return this->distance;
+    return this->table->getDistance(this->row);
 }
 
 void Node::setWeight(int weight) {
-    this->path_weight = weight;
+    this->table->setWeight(this->row, weight);
 }
 
 int Node::getWeight() const {
-    return this->path_weight;
+    return this->table->getWeight(this->row);
 }
 
 bool Node::operator==(const std::shared_ptr<Node>& node) const {
-    return (this->getName() == node->getName());
+    if (this->id == INVALID_NODE_ID) return this == node.get();
+    return (this->getId() == node->getId());
 }
 
-void Node::setColor(const sf::Color &color) {
-    this->shape.setFillColor(color);
-}
-
-
 void Node::setState(NodeState state) {
-    this->state = state;
-    switch (this->state) {
-        case NODE_START: {
-            this->setColor(START_NODE_COLOR);
-            break;
-        }
-        case NODE_TARGET: {
-            this->setColor(TARGET_NODE_COLOR);
-            break;
-        }
-        case NODE_NEAREST: {
-            this->setColor(NEAREST_NODE_COLOR);
-            break;
-        }
-        case NODE_CURRENT: {
-            this->setColor(CURRENT_NODE_COLOR);
-            break;
-        }
-        case NODE_DISCOVERED: {
-            this->setColor(DISCOVERED_NODE_COLOR);
-            break;
-        }
-        case NODE_UNDISCOVERED: {
-            this->setColor(UNDISCOVERED_NODE_COLOR);
-            break;
-        }
-        case NODE_DONE: {
-            this->setColor(DONE_NODE_COLOR);
-            break;
-        }
-        default: {
-            break;
-        }
-    }
+    this->table->setState(this->row, state);
 }
 
 NodeState Node::getState() const {
-    return this->state;
+    return this->table->getState(this->row);
 }
 
 
 sf::Vector2f Node::getPosition() const {
-    return {this->shape.getPosition().x, this->shape.getPosition().y};
+    return this->table->getPosition(this->row);
 }
 
 void Node::setPosition(float pos_x, float pos_y) {
-    this->shape.setPosition(pos_x, pos_y);
+    this->table->setPosition(this->row, {pos_x, pos_y});
+}
+
+bool Node::contains(float pos_x, float pos_y) const {
+    // the bounds of the drawn circle, which grow by the outline of a toggled node
+    float outline = this->is_toggled ? NODE_OUTLINE_THICKNESS : 0;
+    sf::Vector2f position = this->getPosition();
+    return sf::FloatRect(position.x - outline, position.y - outline, 2 * (RADIUS + outline),
+                         2 * (RADIUS + outline)).contains(pos_x, pos_y);
 }
 
 
 void Node::toggle() {
-    int red = this->shape.getFillColor().r;
-    int green = this->shape.getFillColor().g;
-    int blue = this->shape.getFillColor().b;
-    this->shape.setOutlineThickness(3);
-    this->shape.setFillColor(sf::Color(red, green, blue, 150));
+    this->is_toggled = true;
 }
 
 void Node::untoggle() {
-    int red = this->shape.getFillColor().r;
-    int green = this->shape.getFillColor().g;
-    int blue = this->shape.getFillColor().b;
-    this->shape.setOutlineThickness(0);
-    this->shape.setFillColor(sf::Color(red, green, blue, 255));
+    this->is_toggled = false;
+}
+
+bool Node::isToggled() const {
+    return this->is_toggled;
 }
 
-void Node::setParent(const std::shared_ptr<Node>& parent) {
-    this->parent_node = parent;
+void Node::setParent(uint32_t parent_id) {
+    this->table->setParent(this->row, parent_id);
 }
 
-std::shared_ptr<Node> Node::getParent() const {
-    return this->parent_node;
+uint32_t Node::getParent() const {
+    return this->table->getParent(this->row);
 }
 
 
@@ -7,8 +7,9 @@
  * of shared pointers that point to the object. When there are no more shared pointers
  * pointing to the object, it is automatically deleted.
  *
- * This code uses sf::CircleShape to represent a node in order to provide a simple and flexible
- * way to display nodes in a graphical user interface.
+ * The fields of a node are kept in a row of its graph's NodeTable, so a Node object is only a small handle to
+ * that row. The circles of all the nodes are drawn together by the graph's NodeBatch, and their labels by its
+ * LabelBatch.
  */
 
 
@@ -20,6 +21,9 @@
 #include "SFML/Graphics.hpp"
 #include <string>
 #include <memory>
+#include <cstdint>
+
+class NodeTable;
 
 #define START_NODE_COLOR        (sf::Color::Cyan)
 #define CURRENT_NODE_COLOR      (sf::Color::Yellow)
@@ -28,7 +32,12 @@
 #define DONE_NODE_COLOR         (sf::Color::Blue)
 #define TARGET_NODE_COLOR       (sf::Color::Green)
 #define NEAREST_NODE_COLOR      (sf::Color::Magenta)
+#define DISCOVERED_BACKWARD_NODE_COLOR (sf::Color(255, 140, 0))
+#define DONE_BACKWARD_NODE_COLOR       (sf::Color(110, 0, 160))
 #define NODE_OUTLINE_COLOR      (sf::Color::Yellow)
+#define NODE_OUTLINE_THICKNESS  3 // the width of the outline around a toggled node
+
+#define INVALID_NODE_ID         (UINT32_MAX)
 
 
 enum NodeState
@@ -39,40 +48,45 @@ enum NodeState
     NODE_NEAREST,
     NODE_UNDISCOVERED,
     NODE_DISCOVERED,
-    NODE_DONE
+    NODE_DONE,
+    NODE_DISCOVERED_BACKWARD, // discovered by the search that grows from the target node
+    NODE_DONE_BACKWARD
 };
 
 class Node {
 private:
-    std::string name;
-    sf::CircleShape shape;
-    sf::Font* font;
-    NodeState state = NODE_UNDISCOVERED;
-    std::shared_ptr<Node> parent_node = nullptr;
+    uint32_t id = INVALID_NODE_ID;
+    uint32_t row = 0; // the node's row in the table, which is its id while it's in a graph
+    std::shared_ptr<NodeTable> table; // holds the position, name and run state of the node, see NodeTable
     bool is_toggled = false;
-    int distance = INT_MAX;
-    int path_weight = INT_MAX;
 
 public:
 
-    /** Constructor function that initializes a new Node object with a specified name,
-     * position (x and y coordinates), and font to use for rendering text.
+    /** Constructor function that initializes a new Node object with a specified name and
+     * position (x and y coordinates), in a node table of its own until it's added to a graph.
      *
      * @param name The name of the new Node object.
      * @param pos_x The x-coordinate of the new Node object's position.
      * @param pos_y The y-coordinate of the new Node object's position.
-     * @param text_font A pointer to the SFML font object to use for rendering text.
      */
-    Node(std::string name, float pos_x, float pos_y, sf::Font* text_font);
+    Node(const std::string& name, float pos_x, float pos_y);
+
+
+    /** Returns the fill color a node is drawn with in the given state.
+     *
+     * @param state The state of the node.
+     * @return The fill color of the state.
+     */
+    static sf::Color getStateColor(NodeState state);
 
 
-    /** Renders the Node object on the specified SFML render window and displays the
-     * provided string value.
+    /** Checks whether a point falls within the bounding box of the Node object's circle.
      *
-     * @param window The SFML render window on which to render the Node object.
-     * @param to_print The string value to display on the Node object.
+     * @param pos_x The x-coordinate of the point.
+     * @param pos_y The y-coordinate of the point.
+     * @return True if the point is within the bounds of the node, false otherwise.
      */
-    void render(sf::RenderWindow& window, const std::string& to_print);
+    bool contains(float pos_x, float pos_y) const;
 
 
     /** Checks whether the current Node object collides with the other specified Node object.
@@ -119,21 +133,15 @@ public:
     int getWeight() const;
 
 
-    /** Compares two Node objects for equality based on their names.
+    /** Compares two Node objects for equality based on their ids. A Node object that isn't in a graph is only equal
+     * to itself.
      *
      * @param node A shared pointer to a Node object to compare against.
-     * @return True if the two Node objects have the same name, false otherwise.
+     * @return True if the two Node objects have the same id, false otherwise.
      */
     bool operator==(const std::shared_ptr<Node>& node) const;
 
 
-    /** Sets the fill color of the circle shape used to render this Node object.
-     *
-     * @param color The new fill color to use for the circle shape.
-     */
-    void setColor(const sf::Color& color);
-
-
     /** Sets the current state of this Node object.
      *
      * @param state The new state to set for this Node object.
@@ -151,16 +159,16 @@ public:
 
     /** Sets the parent Node of this Node object in a graph search algorithm.
      *
-     * @param parent A shared pointer to the Node object that will be set as the parent of this Node.
+     * @param parent_id The id of the Node object that will be set as the parent of this Node, or INVALID_NODE_ID.
      */
-    void setParent(const std::shared_ptr<Node>& parent);
+    void setParent(uint32_t parent_id);
 
 
     /** Gets the parent Node of this Node object in a graph search algorithm.
      *
-     * @return A shared pointer to the parent Node of this Node, or nullptr if no parent has been set.
+     * @return The id of the parent Node of this Node, or INVALID_NODE_ID if no parent has been set in this run.
      */
-    std::shared_ptr<Node> getParent() const;
+    uint32_t getParent() const;
 
 
     /** Toggles the appearance of the node by adding an outline to the circle shape and reducing
@@ -175,20 +183,60 @@ public:
     void untoggle();
 
 
-    /** Returns a SFML CircleShape object representing the visual shape of the Node object.
+    /** Returns whether the node is toggled.
      *
-     * @return A SFML CircleShape object representing the visual shape of the Node object.
+     * @return True if the node is toggled, false otherwise.
      */
-    sf::CircleShape getShape() const;
+    bool isToggled() const;
 
 
     /** Returns the name of the Node object as a string.
+     *
+     * The name is only used for displaying and saving the node, the graph identifies nodes by their ids.
      *
      * @return A string value representing the name of the Node object.
      */
     std::string getName() const;
 
 
+    /** Sets the name of the Node object.
+     *
+     * @param name The new name of the Node object.
+     */
+    void setName(const std::string& name);
+
+
+    /** Returns the dense id the graph assigned to the Node object.
+     *
+     * @return The id of the Node object, or INVALID_NODE_ID if it wasn't added to a graph.
+     */
+    uint32_t getId() const;
+
+
+    /** Moves the Node object into the node table of a graph, keeping its current state. Called by the graph when
+     * the node is added to it.
+     *
+     * @param graph_table The node table of the graph, which already has a row for the id.
+     * @param id The new id of the Node object.
+     */
+    void attach(const std::shared_ptr<NodeTable>& graph_table, uint32_t id);
+
+
+    /** Moves the Node object out of the node table of its graph into a table of its own, keeping its current state.
+     * Called by the graph when the node is removed from it, so the node's id can be given to another node. The Node
+     * object's id becomes INVALID_NODE_ID.
+     *
+     */
+    void detach();
+
+
+    /** Returns the run of the node table the Node object is in, which its edges tag their state with.
+     *
+     * @return The current run of the node's table.
+     */
+    uint32_t getRun() const;
+
+
     /** Returns the current state of the Node object.
      *
      * @return A NodeState enum value representing the current state of the Node object.
@@ -0,0 +1,87 @@
+#include "NodeBatch.h"
+#include <algorithm>
+#include <cmath>
+
+
+const sf::Texture& NodeBatch::getTexture() {
+    static const sf::Texture texture = []() {
+        sf::Image image;
+        image.create(2 * NODE_TEXTURE_SIZE, NODE_TEXTURE_SIZE, sf::Color::Transparent);
+        float center = NODE_TEXTURE_SIZE / 2.f;
+        for (unsigned int y = 0; y < NODE_TEXTURE_SIZE; y++) {
+            for (unsigned int x = 0; x < NODE_TEXTURE_SIZE; x++) {
+                float distance = std::hypot((float)x + 0.5f - center, (float)y + 0.5f - center);
+                // the share of the pixel inside the circle, and inside the ring around it, for smooth edges
+                float circle = std::clamp(NODE_RADIUS + 0.5f - distance, 0.f, 1.f);
+                float ring = std::clamp(std::min(distance - NODE_RADIUS + 0.5f,
+                                                 NODE_RADIUS + NODE_OUTLINE_THICKNESS + 0.5f - distance), 0.f, 1.f);
+                image.setPixel(x, y, sf::Color(255, 255, 255, (sf::Uint8)(circle * 255)));
+                image.setPixel(NODE_TEXTURE_SIZE + x, y, sf::Color(255, 255, 255, (sf::Uint8)(ring * 255)));
+            }
+        }
+        sf::Texture node_texture;
+        node_texture.loadFromImage(image);
+        node_texture.setSmooth(true);
+        return node_texture;
+    }();
+    return texture;
+}
+
+
+void NodeBatch::fillQuad(sf::Vertex* quad, sf::Vector2f position, float texture_left, sf::Color color) {
+    // the quad is centered on the node's circle, and leaves room for the outline around it
+    float left = position.x - NODE_OUTLINE_THICKNESS;
+    float top = position.y - NODE_OUTLINE_THICKNESS;
+    float size = NODE_TEXTURE_SIZE;
+    quad[0] = sf::Vertex({left, top}, color, {texture_left, 0});
+    quad[1] = sf::Vertex({left + size, top}, color, {texture_left + size, 0});
+    quad[2] = sf::Vertex({left + size, top + size}, color, {texture_left + size, size});
+    quad[3] = sf::Vertex({left, top + size}, color, {texture_left, size});
+}
+
+
+void NodeBatch::fillSlot(uint32_t id, const std::shared_ptr<Node>& node) {
+    NodeSlot& slot = this->slots[id];
+    sf::Vertex* quad = &this->circles[4 * id];
+    if (!node) {
+        slot.is_used = false;
+        for (int i = 0; i < 4; i++) quad[i] = sf::Vertex();
+        return;
+    }
+    slot.is_used = true;
+    slot.position = node->getPosition();
+    slot.state = node->getState();
+    slot.is_toggled = node->isToggled();
+    sf::Color color = Node::getStateColor(slot.state);
+    if (slot.is_toggled) color.a = 150;
+    fillQuad(quad, slot.position, 0, color);
+}
+
+
+void NodeBatch::render(sf::RenderTarget& target, const std::vector<std::shared_ptr<Node>>& nodes_list) {
+    if (this->slots.size() < nodes_list.size()) {
+        this->slots.resize(nodes_list.size());
+        this->circles.resize(4 * nodes_list.size());
+    }
+    this->outlines.clear();
+    for (uint32_t id = 0; id < this->slots.size(); id++) {
+        const std::shared_ptr<Node>& node = (id < nodes_list.size()) ? nodes_list[id] : nullptr;
+        const NodeSlot& slot = this->slots[id];
+        if (!node) {
+            if (slot.is_used) this->fillSlot(id, nullptr);
+            continue;
+        }
+        if (!slot.is_used || node->getPosition() != slot.position || node->getState() != slot.state ||
+            node->isToggled() != slot.is_toggled) {
+            this->fillSlot(id, node);
+        }
+        if (slot.is_toggled) {
+            sf::Vertex quad[4];
+            fillQuad(quad, slot.position, NODE_TEXTURE_SIZE, NODE_OUTLINE_COLOR);
+            for (const sf::Vertex& vertex : quad) this->outlines.append(vertex);
+        }
+    }
+    sf::RenderStates states(&getTexture());
+    target.draw(this->circles, states);
+    if (this->outlines.getVertexCount() > 0) target.draw(this->outlines, states);
+}
@@ -0,0 +1,87 @@
+/**
+ * This code represents the circles of all the nodes of a graph, kept in vertex arrays so that they are drawn with
+ * two draw calls instead of one per node.
+ *
+ * The circle is rasterized once into a texture, next to the ring of the outline a toggled node has. Every node id
+ * has a slot of 4 vertices in an array of quads that cover the circle part of the texture, with the color of the
+ * node's state in its vertices, and the toggled nodes get a quad over the ring part in a second array that is drawn
+ * after the first. A slot remembers the position and state it was last filled with, and only the slots whose node
+ * moved or changed are filled again when the nodes are drawn.
+ */
+
+#ifndef ALGOVIZ_NODEBATCH_H
+#define ALGOVIZ_NODEBATCH_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Node.h"
+#include "Edge.h"
+#include "SFML/Graphics.hpp"
+
+#define NODE_TEXTURE_SIZE (2 * (NODE_RADIUS + NODE_OUTLINE_THICKNESS)) // the side of every part of the texture
+
+
+class NodeBatch {
+    struct NodeSlot {
+        bool is_used = false; // false for free ids, whose quad covers nothing
+        sf::Vector2f position; // the position, state and toggle of the node when the slot was last filled
+        NodeState state = NODE_UNDISCOVERED;
+        bool is_toggled = false;
+    };
+
+    std::vector<NodeSlot> slots; // indexed by node id
+    sf::VertexArray circles = sf::VertexArray(sf::Quads); // 4 vertices for every slot
+    sf::VertexArray outlines = sf::VertexArray(sf::Quads); // 4 vertices for every toggled node
+
+
+    /** Returns the texture the nodes are drawn with, which is made the first time it's asked for. The circle takes
+     * its left half and the ring of the outline its right half, both white so the vertices color them.
+     *
+     * @return The texture of the nodes.
+     */
+    static const sf::Texture& getTexture();
+
+
+    /** Sets the 4 vertices of a quad that covers a node and a part of the texture.
+     *
+     * @param quad - the first of the quad's vertices
+     * @param position - the position of the node
+     * @param texture_left - the left side of the part of the texture
+     * @param color - the color of the quad
+     */
+    static void fillQuad(sf::Vertex* quad, sf::Vector2f position, float texture_left, sf::Color color);
+
+
+    /** Fills the vertices of a slot from the node with its id.
+     *
+     * @param id - the id of the slot
+     * @param node - the node with the id, or nullptr if the id is free
+     */
+    void fillSlot(uint32_t id, const std::shared_ptr<Node>& node);
+
+public:
+
+    /** Constructs a batch with no nodes.
+     *
+     */
+    NodeBatch() = default;
+
+
+    /** Refills the slots of the nodes that changed since they were last drawn, then draws all of them at once.
+     *
+     * @param target - the render target to draw the nodes on
+     * @param nodes_list - the graph's nodes indexed by their ids, nullptr for free ids
+     */
+    void render(sf::RenderTarget& target, const std::vector<std::shared_ptr<Node>>& nodes_list);
+
+
+    /** Default destructor.
+     *
+     */
+    ~NodeBatch() = default;
+
+};
+
+
+#endif //ALGOVIZ_NODEBATCH_H
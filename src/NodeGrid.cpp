@@ -0,0 +1,66 @@
+#include "NodeGrid.h"
+#include <algorithm>
+#include <cmath>
+
+
+uint64_t NodeGrid::cellKey(int32_t cell_x, int32_t cell_y) {
+    return ((uint64_t)(uint32_t)cell_x << 32) | (uint32_t)cell_y;
+}
+
+
+sf::Vector2i NodeGrid::cellOf(sf::Vector2f point) {
+    return {(int)std::floor(point.x / NODE_GRID_CELL_SIZE), (int)std::floor(point.y / NODE_GRID_CELL_SIZE)};
+}
+
+
+sf::Vector2f NodeGrid::centerOf(sf::Vector2f position) {
+    return position + sf::Vector2f(NODE_RADIUS, NODE_RADIUS);
+}
+
+
+void NodeGrid::insert(uint32_t id, sf::Vector2f position) {
+    if (id >= this->is_indexed.size()) {
+        this->is_indexed.resize(id + 1, 0);
+        this->node_cells.resize(id + 1);
+    }
+    sf::Vector2i cell = cellOf(centerOf(position));
+    uint64_t key = cellKey(cell.x, cell.y);
+    this->cells[key].push_back(id);
+    this->node_cells[id] = key;
+    this->is_indexed[id] = 1;
+}
+
+
+void NodeGrid::remove(uint32_t id) {
+    if (id >= this->is_indexed.size() || !this->is_indexed[id]) return;
+    auto found = this->cells.find(this->node_cells[id]);
+    std::vector<uint32_t>& ids = found->second;
+    ids.erase(std::find(ids.begin(), ids.end(), id));
+    if (ids.empty()) this->cells.erase(found);
+    this->is_indexed[id] = 0;
+}
+
+
+void NodeGrid::move(uint32_t id, sf::Vector2f position) {
+    if (id >= this->is_indexed.size() || !this->is_indexed[id]) return;
+    sf::Vector2i cell = cellOf(centerOf(position));
+    if (cellKey(cell.x, cell.y) == this->node_cells[id]) return;
+    this->remove(id);
+    this->insert(id, position);
+}
+
+
+uint32_t NodeGrid::find(sf::Vector2f position, bool is_point, const std::function<bool(uint32_t)>& matches) const {
+    sf::Vector2i cell = cellOf(is_point ? position : centerOf(position));
+    uint32_t found_id = INVALID_NODE_ID;
+    for (int32_t cell_x = cell.x - 1; cell_x <= cell.x + 1; cell_x++) {
+        for (int32_t cell_y = cell.y - 1; cell_y <= cell.y + 1; cell_y++) {
+            auto found = this->cells.find(cellKey(cell_x, cell_y));
+            if (found == this->cells.end()) continue;
+            for (uint32_t id : found->second) {
+                if (id < found_id && matches(id)) found_id = id;
+            }
+        }
+    }
+    return found_id;
+}
@@ -0,0 +1,106 @@
+/**
+ * This code represents a uniform grid over the canvas that indexes the nodes of a graph by the centers of their
+ * circles, so that finding the node under a point or the nodes a node collides with looks at a few cells instead of
+ * every node.
+ *
+ * The side of a cell is the diameter of a node, which is as far as two colliding centers can be apart, and further
+ * than a point can be from the center of a node whose circle it's on. So the nodes a query can match are all in the
+ * 3x3 cells around the cell of the queried point. Only the cells that hold nodes are kept.
+ */
+
+#ifndef ALGOVIZ_NODEGRID_H
+#define ALGOVIZ_NODEGRID_H
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "Node.h"
+#include "Edge.h"
+#include "SFML/Graphics.hpp"
+
+#define NODE_GRID_CELL_SIZE (2.f * NODE_RADIUS) // the side of a cell of the grid
+
+
+class NodeGrid {
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells; // cell key -> the ids of the nodes centered in it
+    std::vector<uint64_t> node_cells; // the key of every indexed node's cell, indexed by node id
+    std::vector<uint8_t> is_indexed; // 1 for the ids of the nodes in the grid
+
+
+    /** Returns the key of the cell at the given cell coordinates.
+     *
+     * @param cell_x - the column of the cell
+     * @param cell_y - the row of the cell
+     * @return The key of the cell.
+     */
+    static uint64_t cellKey(int32_t cell_x, int32_t cell_y);
+
+
+    /** Returns the cell coordinates of the cell a point is in.
+     *
+     * @param point - the point
+     * @return The column and row of the cell.
+     */
+    static sf::Vector2i cellOf(sf::Vector2f point);
+
+
+    /** Returns the center of the circle of a node at the given position.
+     *
+     * @param position - the position of the node
+     * @return The center of the node's circle.
+     */
+    static sf::Vector2f centerOf(sf::Vector2f position);
+
+public:
+
+    /** Constructs a grid with no nodes.
+     *
+     */
+    NodeGrid() = default;
+
+
+    /** Adds a node to the grid.
+     *
+     * @param id - the id of the node, which isn't in the grid yet
+     * @param position - the position of the node
+     */
+    void insert(uint32_t id, sf::Vector2f position);
+
+
+    /** Takes a node out of the grid.
+     *
+     * @param id - the id of the node, nothing happens if it isn't in the grid
+     */
+    void remove(uint32_t id);
+
+
+    /** Moves a node to the cell of its new position.
+     *
+     * @param id - the id of the node, nothing happens if it isn't in the grid
+     * @param position - the new position of the node
+     */
+    void move(uint32_t id, sf::Vector2f position);
+
+
+    /** Finds the node with the smallest id among the nodes near a point that match a condition, which is the node
+     * a scan over the nodes by id would find first.
+     *
+     * @param position - the position of a node, or a point on the canvas when is_point is true
+     * @param is_point - true if position is a point rather than the position of a node
+     * @param matches - the condition, called with the ids of the nodes whose circle may have the point on it or may
+     *                  collide with a node at the position
+     * @return The id of the node found, or INVALID_NODE_ID if no node near the point matches.
+     */
+    uint32_t find(sf::Vector2f position, bool is_point, const std::function<bool(uint32_t)>& matches) const;
+
+
+    /** Default destructor.
+     *
+     */
+    ~NodeGrid() = default;
+
+};
+
+
+#endif //ALGOVIZ_NODEGRID_H
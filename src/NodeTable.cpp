@@ -0,0 +1,132 @@
+#include "NodeTable.h"
+#include <climits>
+
+
+NodeTable::NodeTable(uint32_t rows_count) {
+    this->grow(rows_count);
+}
+
+
+uint32_t NodeTable::size() const {
+    return (uint32_t)this->runs.size();
+}
+
+
+void NodeTable::grow(uint32_t rows_count) {
+    if (rows_count <= this->size()) return;
+    // run 0 is never current, so the new rows read as undiscovered
+    this->runs.resize(rows_count, 0);
+    this->states.resize(rows_count, NODE_UNDISCOVERED);
+    this->distances.resize(rows_count, INT_MAX);
+    this->weights.resize(rows_count, INT_MAX);
+    this->parents.resize(rows_count, INVALID_NODE_ID);
+    this->positions.resize(rows_count);
+    this->is_moved.resize(rows_count, 0);
+    this->names.resize(rows_count);
+}
+
+
+void NodeTable::startRun() {
+    this->run++;
+}
+
+
+uint32_t NodeTable::getRun() const {
+    return this->run;
+}
+
+
+void NodeTable::touch(uint32_t row) {
+    if (this->runs[row] == this->run) return;
+    this->runs[row] = this->run;
+    this->states[row] = NODE_UNDISCOVERED;
+    this->distances[row] = INT_MAX;
+    this->weights[row] = INT_MAX;
+    this->parents[row] = INVALID_NODE_ID;
+}
+
+
+void NodeTable::copyRow(const NodeTable& other, uint32_t other_row, uint32_t row) {
+    this->touch(row);
+    this->states[row] = other.getState(other_row);
+    this->distances[row] = other.getDistance(other_row);
+    this->weights[row] = other.getWeight(other_row);
+    this->parents[row] = other.getParent(other_row);
+    this->positions[row] = other.positions[other_row];
+    this->names[row] = other.names[other_row];
+}
+
+
+NodeState NodeTable::getState(uint32_t row) const {
+    return (this->runs[row] == this->run) ? this->states[row] : NODE_UNDISCOVERED;
+}
+
+
+void NodeTable::setState(uint32_t row, NodeState state) {
+    this->touch(row);
+    this->states[row] = state;
+}
+
+
+int NodeTable::getDistance(uint32_t row) const {
+    return (this->runs[row] == this->run) ? this->distances[row] : INT_MAX;
+}
+
+
+void NodeTable::setDistance(uint32_t row, int distance) {
+    this->touch(row);
+    this->distances[row] = distance;
+}
+
+
+int NodeTable::getWeight(uint32_t row) const {
+    return (this->runs[row] == this->run) ? this->weights[row] : INT_MAX;
+}
+
+
+void NodeTable::setWeight(uint32_t row, int weight) {
+    this->touch(row);
+    this->weights[row] = weight;
+}
+
+
+uint32_t NodeTable::getParent(uint32_t row) const {
+    return (this->runs[row] == this->run) ? this->parents[row] : INVALID_NODE_ID;
+}
+
+
+void NodeTable::setParent(uint32_t row, uint32_t parent_id) {
+    this->touch(row);
+    this->parents[row] = parent_id;
+}
+
+
+sf::Vector2f NodeTable::getPosition(uint32_t row) const {
+    return this->positions[row];
+}
+
+
+void NodeTable::setPosition(uint32_t row, sf::Vector2f position) {
+    this->positions[row] = position;
+    if (this->is_moved[row]) return;
+    this->is_moved[row] = 1;
+    this->moved_rows.push_back(row);
+}
+
+
+std::vector<uint32_t> NodeTable::takeMovedRows() {
+    std::vector<uint32_t> rows;
+    rows.swap(this->moved_rows);
+    for (uint32_t row : rows) this->is_moved[row] = 0;
+    return rows;
+}
+
+
+const std::string& NodeTable::getName(uint32_t row) const {
+    return this->names[row];
+}
+
+
+void NodeTable::setName(uint32_t row, const std::string& name) {
+    this->names[row] = name;
+}
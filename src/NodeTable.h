@@ -0,0 +1,123 @@
+/**
+ * This code represents the per-node data of a graph, kept in one dense array per field and indexed by node id.
+ * The fields the algorithms and the playback go over every step sit in small arrays of their own, apart from the
+ * names and from the shapes, which are only made from the positions and states when the nodes are drawn.
+ *
+ * The fields an algorithm run sets, which are the state, distance, weight and parent of every node, are tagged with
+ * the run they were set in. Starting a new run only moves the table to the next run number, and a row that wasn't
+ * set since then reads as an undiscovered node with no distance, weight or parent. That way resetting the graph
+ * between runs and after every edit doesn't have to walk all of its nodes and edges.
+ *
+ * A Node object reads and writes its row of the table of the graph it's in. Nodes that aren't in a graph, because
+ * they weren't added yet or were removed, have a table of their own with a single row.
+ */
+
+#ifndef ALGOVIZ_NODETABLE_H
+#define ALGOVIZ_NODETABLE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Node.h"
+
+
+class NodeTable {
+    uint32_t run = 1; // the current run, 32 bits of runs are far more than a session can start
+    std::vector<uint32_t> runs; // the run every row's fields were last set in
+    std::vector<NodeState> states;
+    std::vector<int> distances;
+    std::vector<int> weights;
+    std::vector<uint32_t> parents; // the id of every node's parent, INVALID_NODE_ID for none
+    std::vector<sf::Vector2f> positions; // the top left corner of every node's circle
+    std::vector<uint8_t> is_moved; // 1 for the rows in moved_rows
+    std::vector<uint32_t> moved_rows; // the rows whose position was set since takeMovedRows was last called
+    std::vector<std::string> names;
+
+
+    /** Clears the run fields of a row that wasn't set in the current run yet, before one of them is set.
+     *
+     * @param row - the row of the node
+     */
+    void touch(uint32_t row);
+
+public:
+
+    /** Constructs a table with rows that read as undiscovered nodes.
+     *
+     * @param rows_count - the number of rows
+     */
+    explicit NodeTable(uint32_t rows_count = 0);
+
+
+    /** Returns the number of rows in the table.
+     *
+     * @return The number of rows.
+     */
+    uint32_t size() const;
+
+
+    /** Adds rows to the end of the table until it has at least the given number of rows.
+     *
+     * @param rows_count - the least number of rows
+     */
+    void grow(uint32_t rows_count);
+
+
+    /** Starts a new run, after which every row reads as an undiscovered node until it's set again. Takes constant
+     * time.
+     *
+     */
+    void startRun();
+
+
+    /** Returns the current run number, which edges tag their own state with.
+     *
+     * @return The current run.
+     */
+    uint32_t getRun() const;
+
+
+    /** Copies a row of another table, with the fields of its current run, into a row of this one.
+     *
+     * @param other - the table to copy from
+     * @param other_row - the row to copy
+     * @param row - the row to copy to
+     */
+    void copyRow(const NodeTable& other, uint32_t other_row, uint32_t row);
+
+
+    NodeState getState(uint32_t row) const;
+    void setState(uint32_t row, NodeState state);
+
+    int getDistance(uint32_t row) const;
+    void setDistance(uint32_t row, int distance);
+
+    int getWeight(uint32_t row) const;
+    void setWeight(uint32_t row, int weight);
+
+    uint32_t getParent(uint32_t row) const;
+    void setParent(uint32_t row, uint32_t parent_id);
+
+    sf::Vector2f getPosition(uint32_t row) const;
+    void setPosition(uint32_t row, sf::Vector2f position);
+
+
+    /** Returns the rows whose position was set since the last call, each of them once, and clears them.
+     *
+     * @return The rows of the nodes that moved.
+     */
+    std::vector<uint32_t> takeMovedRows();
+
+    const std::string& getName(uint32_t row) const;
+    void setName(uint32_t row, const std::string& name);
+
+
+    /** Default destructor.
+     *
+     */
+    ~NodeTable() = default;
+
+};
+
+
+#endif //ALGOVIZ_NODETABLE_H
@@ -0,0 +1,119 @@
+#include "ParallelBFS.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <climits>
+#include <thread>
+
+
+ParallelBFS::ParallelBFS(const AdjacencyArray& adjacency, unsigned int threads_count): adjacency(adjacency) {
+    if (threads_count == 0) threads_count = std::thread::hardware_concurrency();
+    this->threads_count = std::max(threads_count, 1u);
+}
+
+
+bool ParallelBFS::run(uint32_t source, std::stop_token stop_token) {
+    uint32_t nodes_count = this->adjacency.size();
+    this->distances.assign(nodes_count, INT_MAX);
+    this->parents.assign(nodes_count, INVALID_NODE_ID);
+    this->claims = std::make_unique<std::atomic<uint64_t>[]>(nodes_count);
+    for (uint32_t id = 0; id < nodes_count; id++) this->claims[id].store(UINT64_MAX, std::memory_order_relaxed);
+    this->distances[source] = 0;
+    this->frontier.assign(1, source);
+    this->chunk_buffers.resize(1);
+    this->frontier_offset = 0;
+    this->next_chunk = 0;
+    this->is_done = false;
+
+    // every level runs as one group of workers that claim the neighbors, then one that collects them
+    for (int level = 0; !this->is_done; level++) {
+        if (stop_token.stop_requested()) return false;
+        this->runWorkers([this]() { this->claimNeighbors(); });
+        this->next_chunk = 0;
+        this->runWorkers([this, level]() { this->collectNeighbors(level); });
+        this->advanceLevel();
+    }
+    return true;
+}
+
+
+void ParallelBFS::runWorkers(const std::function<void()>& worker) {
+    if (this->chunk_buffers.size() <= 1) {
+        // waking the pool costs more than a single chunk, which no other worker could take anyway
+        worker();
+        return;
+    }
+    // the chunks are taken one at a time by whichever worker is free, so the workers balance themselves
+    TaskGroup group;
+    for (unsigned int i = 1; i < this->threads_count; i++) group.run(worker);
+    worker();
+    group.wait();
+}
+
+
+uint64_t ParallelBFS::edgeOrder(size_t frontier_index, int position) const {
+    uint64_t queue_position = this->frontier_offset + frontier_index;
+    return (queue_position << 32) | (uint32_t)(position - this->adjacency.rowBegin(this->frontier[frontier_index]));
+}
+
+
+void ParallelBFS::claimNeighbors() {
+    size_t chunks_count = this->chunk_buffers.size();
+    for (size_t chunk = this->next_chunk++; chunk < chunks_count; chunk = this->next_chunk++) {
+        size_t chunk_end = std::min((chunk + 1) * PARALLEL_BFS_CHUNK_SIZE, this->frontier.size());
+        for (size_t i = chunk * PARALLEL_BFS_CHUNK_SIZE; i < chunk_end; i++) {
+            uint32_t current = this->frontier[i];
+            for (int j = this->adjacency.rowBegin(current); j < this->adjacency.rowEnd(current); j++) {
+                uint32_t neighbor = this->adjacency.getNeighbor(j);
+                // distances only change in the collect phase, so reading them here doesn't race
+                if (this->distances[neighbor] != INT_MAX) continue;
+                uint64_t order = this->edgeOrder(i, j);
+                uint64_t claimed_order = this->claims[neighbor].load(std::memory_order_relaxed);
+                while (order < claimed_order &&
+                       !this->claims[neighbor].compare_exchange_weak(claimed_order, order, std::memory_order_relaxed));
+            }
+        }
+    }
+}
+
+
+void ParallelBFS::collectNeighbors(int level) {
+    size_t chunks_count = this->chunk_buffers.size();
+    for (size_t chunk = this->next_chunk++; chunk < chunks_count; chunk = this->next_chunk++) {
+        std::vector<uint32_t>& buffer = this->chunk_buffers[chunk];
+        buffer.clear();
+        size_t chunk_end = std::min((chunk + 1) * PARALLEL_BFS_CHUNK_SIZE, this->frontier.size());
+        for (size_t i = chunk * PARALLEL_BFS_CHUNK_SIZE; i < chunk_end; i++) {
+            uint32_t current = this->frontier[i];
+            for (int j = this->adjacency.rowBegin(current); j < this->adjacency.rowEnd(current); j++) {
+                uint32_t neighbor = this->adjacency.getNeighbor(j);
+                // queue positions are never reused, so only the edge that won the claim matches it
+                if (this->claims[neighbor].load(std::memory_order_relaxed) != this->edgeOrder(i, j)) continue;
+                this->distances[neighbor] = level + 1;
+                this->parents[neighbor] = current;
+                buffer.push_back(neighbor);
+            }
+        }
+    }
+}
+
+
+void ParallelBFS::advanceLevel() {
+    this->frontier_offset += (uint32_t)this->frontier.size();
+    this->frontier.clear();
+    for (const std::vector<uint32_t>& buffer : this->chunk_buffers) {
+        this->frontier.insert(this->frontier.end(), buffer.begin(), buffer.end());
+    }
+    this->chunk_buffers.resize((this->frontier.size() + PARALLEL_BFS_CHUNK_SIZE - 1) / PARALLEL_BFS_CHUNK_SIZE);
+    this->next_chunk = 0;
+    this->is_done = this->frontier.empty();
+}
+
+
+const std::vector<int>& ParallelBFS::getDistances() const {
+    return this->distances;
+}
+
+
+const std::vector<uint32_t>& ParallelBFS::getParents() const {
+    return this->parents;
+}
@@ -0,0 +1,120 @@
+/**
+ * This code provides a headless, level-synchronous breadth-first search over an adjacency array that splits every
+ * level of the search across a group of worker threads.
+ *
+ * The frontier of a level is cut into chunks that the workers take one at a time. A node can be reached by several
+ * frontier nodes in the same level, so every reaching edge tries to claim the node with an atomic compare-and-swap,
+ * and the edge that comes first in the order of a queue-based BFS wins. Every chunk then collects the nodes its
+ * edges won into its own buffer, and the buffers are joined in chunk order into the next frontier. This gives
+ * every node the same distance and the same parent as a queue-based BFS, no matter how the work was split.
+ *
+ * The workers are tasks of the shared thread pool, see ThreadPool.
+ */
+
+#ifndef ALGOVIZ_PARALLELBFS_H
+#define ALGOVIZ_PARALLELBFS_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stop_token>
+#include <vector>
+#include "AdjacencyArray.h"
+
+#define PARALLEL_BFS_CHUNK_SIZE 256 // the number of frontier nodes a worker takes at a time
+
+
+class ParallelBFS {
+    const AdjacencyArray& adjacency;
+    unsigned int threads_count;
+    std::vector<int> distances; // distance of every node from the source, indexed by node id, INT_MAX if unreached
+    std::vector<uint32_t> parents; // the node every node was reached from, indexed by node id
+    std::unique_ptr<std::atomic<uint64_t>[]> claims; // the order of the edge that reached every node first
+    std::vector<uint32_t> frontier; // ids of the nodes in the current level, in the order a queue would hold them
+    std::vector<std::vector<uint32_t>> chunk_buffers; // the nodes every chunk of the frontier reached, in order
+    uint32_t frontier_offset = 0; // the queue position of the first node of the frontier
+    std::atomic<size_t> next_chunk = 0; // the next chunk of the frontier a worker should take
+    bool is_done = false;
+
+
+    /** Returns the order in which a queue-based BFS would scan an edge.
+     *
+     * @param frontier_index - the index in the frontier of the node the edge is scanned from
+     * @param position - the adjacency position of the edge
+     * @return The queue position of the node the edge is scanned from in the high bits, and the edge's index in
+     * the node's row in the low bits.
+     */
+    uint64_t edgeOrder(size_t frontier_index, int position) const;
+
+
+    /** Tries to claim the unreached neighbors of the frontier nodes in the chunks the calling worker takes.
+     *
+     */
+    void claimNeighbors();
+
+
+    /** Collects the neighbors claimed by the frontier nodes in the chunks the calling worker takes into the
+     * buffers of those chunks, and sets their distances and parents.
+     *
+     * @param level - the distance of the current level from the source
+     */
+    void collectNeighbors(int level);
+
+
+    /** Runs a phase of the current level on threads_count workers of the shared pool, the calling thread being one
+     * of them, and returns once all of them are done. A level that fits in a single chunk only has work for one
+     * worker, so it runs on the calling thread alone.
+     *
+     * @param worker - the phase to run on every worker
+     */
+    void runWorkers(const std::function<void()>& worker);
+
+
+    /** Joins the chunk buffers into the next frontier. Called once all workers are done collecting.
+     *
+     */
+    void advanceLevel();
+
+public:
+
+    /** Constructs a parallel BFS engine over an adjacency array.
+     *
+     * @param adjacency - the adjacency array to search, which must outlive the engine
+     * @param threads_count - the number of workers, or 0 to use one per hardware thread
+     */
+    ParallelBFS(const AdjacencyArray& adjacency, unsigned int threads_count = 0);
+
+
+    /** Runs the search from a source node, replacing the results of any previous run.
+     *
+     * @param source - the id of the node to start from
+     * @param stop_token - stops the search between two levels when a stop is requested
+     * @return True if the search reached every node it could, false if it was stopped before.
+     */
+    bool run(uint32_t source, std::stop_token stop_token = {});
+
+
+    /** Returns the distance of every node from the source of the last run.
+     *
+     * @return The distances indexed by node id, INT_MAX for nodes that weren't reached.
+     */
+    const std::vector<int>& getDistances() const;
+
+
+    /** Returns the node every node was reached from in the last run.
+     *
+     * @return The parent ids indexed by node id, INVALID_NODE_ID for the source and for nodes that weren't reached.
+     */
+    const std::vector<uint32_t>& getParents() const;
+
+
+    /** Default destructor.
+     *
+     */
+    ~ParallelBFS() = default;
+
+};
+
+
+#endif //ALGOVIZ_PARALLELBFS_H
@@ -0,0 +1,242 @@
+#include "PriorityQueue.h"
+#include "Node.h"
+#include <algorithm>
+
+
+std::unique_ptr<PriorityQueue> createPriorityQueue(PriorityQueueType type, uint32_t capacity, int max_weight) {
+    if (type == QUEUE_AUTOMATIC) {
+        type = (max_weight <= BUCKET_QUEUE_MAX_WEIGHT) ? QUEUE_BUCKETS : QUEUE_DARY_HEAP;
+    }
+    switch (type) {
+        case QUEUE_PAIRING_HEAP: {
+            return std::make_unique<PairingHeap>(capacity);
+        }
+        case QUEUE_BUCKETS: {
+            return std::make_unique<BucketQueue>(capacity, max_weight);
+        }
+        default: {
+            return std::make_unique<IndexedHeap>(capacity);
+        }
+    }
+}
+
+//--------------------------------------------IndexedHeap methods-------------------------------------------------------
+
+IndexedHeap::IndexedHeap(uint32_t capacity, int arity): keys(capacity), positions(capacity, -1), arity(arity) {}
+
+
+void IndexedHeap::push(uint32_t id, int key) {
+    if (this->positions[id] == -1) {
+        this->keys[id] = key;
+        this->heap.push_back(id);
+        this->positions[id] = (int)this->heap.size() - 1;
+        this->siftUp(this->positions[id]);
+    }
+    else if (key < this->keys[id]) {
+        this->keys[id] = key;
+        this->siftUp(this->positions[id]);
+    }
+}
+
+
+uint32_t IndexedHeap::pop() {
+    uint32_t top = this->heap.front();
+    uint32_t last = this->heap.back();
+    this->heap.pop_back();
+    this->positions[top] = -1;
+    if (!this->heap.empty()) {
+        this->heap[0] = last;
+        this->positions[last] = 0;
+        this->siftDown(0);
+    }
+    return top;
+}
+
+
+int IndexedHeap::topKey() {
+    return this->keys[this->heap.front()];
+}
+
+
+bool IndexedHeap::empty() const {
+    return this->heap.empty();
+}
+
+
+void IndexedHeap::siftUp(int position) {
+    uint32_t id = this->heap[position];
+    while (position > 0) {
+        int parent = (position - 1) / this->arity;
+        if (this->keys[this->heap[parent]] <= this->keys[id]) break;
+        this->heap[position] = this->heap[parent];
+        this->positions[this->heap[position]] = position;
+        position = parent;
+    }
+    this->heap[position] = id;
+    this->positions[id] = position;
+}
+
+
+void IndexedHeap::siftDown(int position) {
+    uint32_t id = this->heap[position];
+    int size = (int)this->heap.size();
+    while (true) {
+        int first_child = position * this->arity + 1;
+        if (first_child >= size) break;
+        int min_child = first_child;
+        int last_child = std::min(first_child + this->arity, size);
+        for (int child = first_child + 1; child < last_child; child++) {
+            if (this->keys[this->heap[child]] < this->keys[this->heap[min_child]]) min_child = child;
+        }
+        if (this->keys[id] <= this->keys[this->heap[min_child]]) break;
+        this->heap[position] = this->heap[min_child];
+        this->positions[this->heap[position]] = position;
+        position = min_child;
+    }
+    this->heap[position] = id;
+    this->positions[id] = position;
+}
+
+//--------------------------------------------PairingHeap methods-------------------------------------------------------
+
+PairingHeap::PairingHeap(uint32_t capacity): nodes(capacity), root(INVALID_NODE_ID) {}
+
+
+void PairingHeap::push(uint32_t id, int key) {
+    HeapNode& node = this->nodes[id];
+    if (!node.is_queued) {
+        node = {key, INVALID_NODE_ID, INVALID_NODE_ID, INVALID_NODE_ID, true};
+        this->root = this->meld(this->root, id);
+        return;
+    }
+    if (key >= node.key) return;
+    node.key = key;
+    if (id == this->root) return;
+
+    // cut the node's subtree out of its parent and meld it back with the root
+    if (this->nodes[node.prev].child == id) this->nodes[node.prev].child = node.sibling;
+    else this->nodes[node.prev].sibling = node.sibling;
+    if (node.sibling != INVALID_NODE_ID) this->nodes[node.sibling].prev = node.prev;
+    node.sibling = INVALID_NODE_ID;
+    node.prev = INVALID_NODE_ID;
+    this->root = this->meld(this->root, id);
+}
+
+
+uint32_t PairingHeap::pop() {
+    uint32_t top = this->root;
+    this->nodes[top].is_queued = false;
+    this->root = this->mergePairs(this->nodes[top].child);
+    return top;
+}
+
+
+int PairingHeap::topKey() {
+    return this->nodes[this->root].key;
+}
+
+
+bool PairingHeap::empty() const {
+    return this->root == INVALID_NODE_ID;
+}
+
+
+uint32_t PairingHeap::meld(uint32_t first, uint32_t second) {
+    if (first == INVALID_NODE_ID) return second;
+    if (second == INVALID_NODE_ID) return first;
+    if (this->nodes[second].key < this->nodes[first].key) std::swap(first, second);
+
+    // the root with the larger key becomes the leftmost child of the other root
+    HeapNode& parent = this->nodes[first];
+    HeapNode& child = this->nodes[second];
+    child.prev = first;
+    child.sibling = parent.child;
+    if (parent.child != INVALID_NODE_ID) this->nodes[parent.child].prev = second;
+    parent.child = second;
+    parent.sibling = INVALID_NODE_ID;
+    parent.prev = INVALID_NODE_ID;
+    return first;
+}
+
+
+uint32_t PairingHeap::mergePairs(uint32_t first) {
+    if (first == INVALID_NODE_ID) return INVALID_NODE_ID;
+
+    // first pass: meld the siblings in pairs from left to right
+    this->pairs.clear();
+    uint32_t current = first;
+    while (current != INVALID_NODE_ID) {
+        uint32_t next = this->nodes[current].sibling;
+        uint32_t after_next = (next == INVALID_NODE_ID) ? INVALID_NODE_ID : this->nodes[next].sibling;
+        this->nodes[current].sibling = this->nodes[current].prev = INVALID_NODE_ID;
+        if (next != INVALID_NODE_ID) this->nodes[next].sibling = this->nodes[next].prev = INVALID_NODE_ID;
+        this->pairs.push_back(this->meld(current, next));
+        current = after_next;
+    }
+
+    // second pass: meld the pairs from right to left
+    uint32_t result = this->pairs.back();
+    for (int i = (int)this->pairs.size() - 2; i >= 0; i--) {
+        result = this->meld(this->pairs[i], result);
+    }
+    return result;
+}
+
+//--------------------------------------------BucketQueue methods-------------------------------------------------------
+
+BucketQueue::BucketQueue(uint32_t capacity, int max_weight): buckets(std::max(max_weight, 0) + 1, INVALID_NODE_ID),
+                                                              next(capacity), prev(capacity), keys(capacity),
+                                                              is_queued(capacity, false) {}
+
+
+void BucketQueue::push(uint32_t id, int key) {
+    if (this->is_queued[id]) {
+        if (key >= this->keys[id]) return;
+        this->unlink(id);
+    }
+    else {
+        this->is_queued[id] = true;
+        this->size++;
+    }
+    // the search for the next node starts at current_key, so it can't be above any queued key
+    if (this->size == 1 || key < this->current_key) this->current_key = key;
+    this->keys[id] = key;
+    this->link(id);
+}
+
+
+uint32_t BucketQueue::pop() {
+    this->topKey();
+    uint32_t top = this->buckets[this->current_key % this->buckets.size()];
+    this->unlink(top);
+    this->is_queued[top] = false;
+    this->size--;
+    return top;
+}
+
+
+int BucketQueue::topKey() {
+    while (this->buckets[this->current_key % this->buckets.size()] == INVALID_NODE_ID) this->current_key++;
+    return this->current_key;
+}
+
+
+bool BucketQueue::empty() const {
+    return this->size == 0;
+}
+
+
+void BucketQueue::link(uint32_t id) {
+    uint32_t& head = this->buckets[this->keys[id] % this->buckets.size()];
+    this->prev[id] = INVALID_NODE_ID;
+    this->next[id] = head;
+    if (head != INVALID_NODE_ID) this->prev[head] = id;
+    head = id;
+}
+
+
+void BucketQueue::unlink(uint32_t id) {
+    if (this->prev[id] != INVALID_NODE_ID) this->next[this->prev[id]] = this->next[id];
+    else this->buckets[this->keys[id] % this->buckets.size()] = this->next[id];
+    if (this->next[id] != INVALID_NODE_ID) this->prev[this->next[id]] = this->prev[id];
+}
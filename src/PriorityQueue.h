@@ -0,0 +1,241 @@
+/**
+ * This code provides the priority queues used by Dijkstra's algorithm to pick the next node to settle.
+ * All of them are indexed by node id and support decrease-key, so every node is stored at most once
+ * and the algorithm never has to scan the whole graph for the node with the minimum distance.
+ */
+
+#ifndef ALGOVIZ_PRIORITYQUEUE_H
+#define ALGOVIZ_PRIORITYQUEUE_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#define BUCKET_QUEUE_MAX_WEIGHT (1 << 16) // the largest edge weight QUEUE_AUTOMATIC still uses buckets for
+
+enum PriorityQueueType {
+    QUEUE_AUTOMATIC,
+    QUEUE_DARY_HEAP,
+    QUEUE_PAIRING_HEAP,
+    QUEUE_BUCKETS
+};
+
+//-----------------------------------------------PriorityQueue Class----------------------------------------------------
+
+/** The PriorityQueue class is the interface shared by all the priority queues, holding node ids ordered by
+ * an integer key.
+ */
+class PriorityQueue {
+
+public:
+    /** Inserts a node id into the queue, or lowers its key if it is already queued.
+     *
+     * A key that isn't lower than the key the node is already queued with is ignored.
+     *
+     * @param id - the id of the node
+     * @param key - the key of the node
+     */
+    virtual void push(uint32_t id, int key) = 0;
+
+
+    /** Removes the node with the minimum key from the queue.
+     *
+     * @return The id of the removed node.
+     */
+    virtual uint32_t pop() = 0;
+
+
+    /** Returns the minimum key in the queue without removing its node. The queue must not be empty.
+     *
+     * @return The minimum key.
+     */
+    virtual int topKey() = 0;
+
+
+    /** Checks if the queue is empty.
+     *
+     * @return True if there are no nodes in the queue, false otherwise.
+     */
+    [[nodiscard]] virtual bool empty() const = 0;
+
+
+    /** Default destructor.
+     *
+     */
+    virtual ~PriorityQueue() = default;
+
+};
+
+
+/** Creates a priority queue of the given type.
+ *
+ * QUEUE_AUTOMATIC picks the bucket queue when the edge weights are small enough for it, and the d-ary heap otherwise.
+ *
+ * @param type - the type of the priority queue
+ * @param capacity - one past the highest node id that will be pushed to the queue
+ * @param max_weight - the largest edge weight of the graph the queue is used on
+ * @return A pointer to the new priority queue.
+ */
+std::unique_ptr<PriorityQueue> createPriorityQueue(PriorityQueueType type, uint32_t capacity, int max_weight);
+
+//-----------------------------------------------IndexedHeap Class------------------------------------------------------
+
+/** The IndexedHeap class is a d-ary min-heap that remembers the position of every node in it,
+ * so the key of a queued node can be decreased in O(log n).
+ */
+class IndexedHeap : public PriorityQueue {
+
+private:
+    std::vector<uint32_t> heap; // node ids in heap order
+    std::vector<int> keys; // key of every node, indexed by node id
+    std::vector<int> positions; // position of every node in heap, indexed by node id, -1 if not queued
+    int arity;
+
+    /** Moves the node at the given position up until its parent's key isn't greater than its key.
+     *
+     * @param position - the position of the node in the heap
+     */
+    void siftUp(int position);
+
+
+    /** Moves the node at the given position down until none of its children has a smaller key.
+     *
+     * @param position - the position of the node in the heap
+     */
+    void siftDown(int position);
+
+public:
+    /** Constructs an empty heap.
+     *
+     * @param capacity - one past the highest node id that will be pushed to the heap
+     * @param arity - the number of children of every node in the heap
+     */
+    explicit IndexedHeap(uint32_t capacity, int arity = 4);
+
+
+    void push(uint32_t id, int key) override;
+
+
+    uint32_t pop() override;
+
+
+    int topKey() override;
+
+
+    [[nodiscard]] bool empty() const override;
+
+};
+
+//-----------------------------------------------PairingHeap Class------------------------------------------------------
+
+/** The PairingHeap class is a pairing heap, which inserts and decreases keys in O(1) and removes the
+ * minimum in amortized O(log n).
+ */
+class PairingHeap : public PriorityQueue {
+
+private:
+    struct HeapNode {
+        int key = 0;
+        uint32_t child = UINT32_MAX; // leftmost child
+        uint32_t sibling = UINT32_MAX; // next sibling to the right
+        uint32_t prev = UINT32_MAX; // left sibling, or the parent for the leftmost child
+        bool is_queued = false;
+    };
+
+    std::vector<HeapNode> nodes; // indexed by node id
+    std::vector<uint32_t> pairs; // scratch list of melded pairs used by pop()
+    uint32_t root;
+
+    /** Melds two heap roots into one heap.
+     *
+     * @param first - the id of the first root
+     * @param second - the id of the second root
+     * @return The id of the root of the melded heap.
+     */
+    uint32_t meld(uint32_t first, uint32_t second);
+
+
+    /** Melds a list of siblings into one heap using the two-pass pairing method.
+     *
+     * @param first - the id of the leftmost sibling
+     * @return The id of the root of the melded heap.
+     */
+    uint32_t mergePairs(uint32_t first);
+
+public:
+    /** Constructs an empty heap.
+     *
+     * @param capacity - one past the highest node id that will be pushed to the heap
+     */
+    explicit PairingHeap(uint32_t capacity);
+
+
+    void push(uint32_t id, int key) override;
+
+
+    uint32_t pop() override;
+
+
+    int topKey() override;
+
+
+    [[nodiscard]] bool empty() const override;
+
+};
+
+//-----------------------------------------------BucketQueue Class------------------------------------------------------
+
+/** The BucketQueue class is a monotone integer priority queue (Dial's algorithm) for non-negative edge weights
+ * of at most max_weight. Every queued key lies between the last removed key and max_weight above it, so keeping
+ * max_weight + 1 buckets in a circle is enough, and all operations take O(1) amortized time.
+ *
+ * Keys pushed to the queue must not be smaller than the last removed key, which always holds in Dijkstra's algorithm.
+ */
+class BucketQueue : public PriorityQueue {
+
+private:
+    std::vector<uint32_t> buckets; // first node id of every bucket's list
+    std::vector<uint32_t> next; // next node id in the same bucket, indexed by node id
+    std::vector<uint32_t> prev; // previous node id in the same bucket, indexed by node id
+    std::vector<int> keys; // key of every node, indexed by node id
+    std::vector<bool> is_queued; // indexed by node id
+    int current_key = 0; // the key of the bucket the next node is removed from
+    uint32_t size = 0;
+
+    /** Adds a node to the bucket of its key.
+     *
+     * @param id - the id of the node
+     */
+    void link(uint32_t id);
+
+
+    /** Removes a node from the bucket of its key.
+     *
+     * @param id - the id of the node
+     */
+    void unlink(uint32_t id);
+
+public:
+    /** Constructs an empty bucket queue.
+     *
+     * @param capacity - one past the highest node id that will be pushed to the queue
+     * @param max_weight - the largest edge weight of the graph the queue is used on
+     */
+    BucketQueue(uint32_t capacity, int max_weight);
+
+
+    void push(uint32_t id, int key) override;
+
+
+    uint32_t pop() override;
+
+
+    int topKey() override;
+
+
+    [[nodiscard]] bool empty() const override;
+
+};
+
+
+#endif //ALGOVIZ_PRIORITYQUEUE_H
@@ -0,0 +1,54 @@
+#include "TaskScheduler.h"
+
+
+TaskHandle::TaskHandle(std::shared_ptr<TaskState> task): task(std::move(task)) {
+}
+
+
+bool TaskHandle::isRunning() const {
+    return this->task && !this->task->is_done;
+}
+
+
+void TaskHandle::requestStop() {
+    if (this->task) this->task->thread.request_stop();
+}
+
+
+void TaskHandle::wait() {
+    if (this->task && this->task->thread.joinable()) this->task->thread.join();
+}
+
+
+void TaskHandle::cancel() {
+    this->requestStop();
+    this->wait();
+}
+
+
+TaskHandle TaskScheduler::submit(std::function<void(std::stop_token)> job) {
+    // the jobs that returned only wait for their threads to be joined
+    std::erase_if(this->tasks, [](const std::shared_ptr<TaskState>& task) {
+        if (!task->is_done) return false;
+        if (task->thread.joinable()) task->thread.join();
+        return true;
+    });
+
+    std::shared_ptr<TaskState> task = std::make_shared<TaskState>();
+    // the thread only outlives the state's other members if the state is destroyed, and then it's joined first
+    TaskState* state = task.get();
+    task->thread = std::jthread([state, job = std::move(job)](std::stop_token stop_token) {
+        job(stop_token);
+        state->is_done = true;
+    });
+    this->tasks.push_back(task);
+    return TaskHandle(task);
+}
+
+
+TaskScheduler::~TaskScheduler() {
+    for (const std::shared_ptr<TaskState>& task : this->tasks) task->thread.request_stop();
+    for (const std::shared_ptr<TaskState>& task : this->tasks) {
+        if (task->thread.joinable()) task->thread.join();
+    }
+}
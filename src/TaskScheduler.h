@@ -0,0 +1,102 @@
+/**
+ * This code represents a small scheduler for the jobs that run off the window's thread, such as the algorithm runs.
+ *
+ * Every job runs on its own std::jthread and is given a stop token, so it can be cancelled without any shared flags.
+ * The window's thread keeps a TaskHandle for every job it may have to wait for, stop or ask about. The threads of
+ * the jobs that are done are joined when the next job is submitted.
+ */
+
+#ifndef ALGOVIZ_TASKSCHEDULER_H
+#define ALGOVIZ_TASKSCHEDULER_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+
+struct TaskState {
+    std::atomic<bool> is_done = false; // set by the task's thread once the job returns
+    std::jthread thread; // declared last, so it's joined before the rest of the state is destroyed
+};
+
+
+class TaskHandle {
+    std::shared_ptr<TaskState> task;
+
+public:
+
+    /** Constructs a handle that refers to no task.
+     *
+     */
+    TaskHandle() = default;
+
+
+    /** Constructs a handle to a submitted task.
+     *
+     * @param task - the state of the task
+     */
+    explicit TaskHandle(std::shared_ptr<TaskState> task);
+
+
+    /** Returns whether the task is still running its job.
+     *
+     * @return true if the handle refers to a task whose job hasn't returned yet, false otherwise
+     */
+    bool isRunning() const;
+
+
+    /** Asks the task to stop, through the stop token given to its job. Doesn't wait for it.
+     *
+     */
+    void requestStop();
+
+
+    /** Waits until the task's job returns.
+     *
+     */
+    void wait();
+
+
+    /** Asks the task to stop and waits until its job returns.
+     *
+     */
+    void cancel();
+
+};
+
+
+class TaskScheduler {
+    std::vector<std::shared_ptr<TaskState>> tasks; // the tasks whose threads weren't joined yet
+
+public:
+
+    /** Default constructor.
+     *
+     */
+    TaskScheduler() = default;
+
+
+    /** Starts a job on its own thread, and joins the threads of the tasks whose jobs returned.
+     *
+     * @param job - the job to run, which should return soon after a stop is requested on its token
+     * @return A handle to the task.
+     */
+    TaskHandle submit(std::function<void(std::stop_token)> job);
+
+
+    /** Asks every task to stop and waits for them.
+     *
+     */
+    ~TaskScheduler();
+
+
+    TaskScheduler(const TaskScheduler& other) = delete;
+    TaskScheduler& operator=(const TaskScheduler& other) = delete;
+
+};
+
+
+#endif //ALGOVIZ_TASKSCHEDULER_H
@@ -0,0 +1,168 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <utility>
+
+// the pool the calling thread is a worker of, and the index of its queue there
+static thread_local const ThreadPool* worker_pool = nullptr;
+static thread_local size_t worker_queue = 0;
+
+
+ThreadPool::ThreadPool(unsigned int threads_count) {
+    if (threads_count == 0) threads_count = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    for (unsigned int i = 0; i <= threads_count; i++) this->queues.push_back(std::make_unique<TaskQueue>());
+    for (unsigned int i = 0; i < threads_count; i++) this->workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+
+unsigned int ThreadPool::getThreadsCount() const {
+    return (unsigned int)this->workers.size();
+}
+
+
+size_t ThreadPool::currentQueue() const {
+    return (worker_pool == this) ? worker_queue : this->queues.size() - 1;
+}
+
+
+void ThreadPool::submit(std::function<void()> task) {
+    TaskQueue& queue = *this->queues[this->currentQueue()];
+    // counted before it's queued, so the count never drops below the number of queued tasks
+    this->pending_count++;
+    {
+        std::lock_guard<std::mutex> queue_guard(queue.lock);
+        queue.tasks.push_back(std::move(task));
+    }
+    // taking the lock orders the new count before any worker that is about to sleep checks it
+    { std::lock_guard<std::mutex> sleep_guard(this->sleep_lock); }
+    this->wake_condition.notify_one();
+}
+
+
+bool ThreadPool::takeTask(size_t queue_index, std::function<void()>& task) {
+    if (this->pending_count == 0) return false;
+    {
+        TaskQueue& own_queue = *this->queues[queue_index];
+        std::lock_guard<std::mutex> queue_guard(own_queue.lock);
+        if (!own_queue.tasks.empty()) {
+            task = std::move(own_queue.tasks.back());
+            own_queue.tasks.pop_back();
+            this->pending_count--;
+            return true;
+        }
+    }
+    for (size_t i = 1; i < this->queues.size(); i++) {
+        TaskQueue& victim_queue = *this->queues[(queue_index + i) % this->queues.size()];
+        std::lock_guard<std::mutex> queue_guard(victim_queue.lock);
+        if (!victim_queue.tasks.empty()) {
+            task = std::move(victim_queue.tasks.front());
+            victim_queue.tasks.pop_front();
+            this->pending_count--;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+bool ThreadPool::runPendingTask() {
+    std::function<void()> task;
+    if (!this->takeTask(this->currentQueue(), task)) return false;
+    task();
+    return true;
+}
+
+
+void ThreadPool::workerLoop(size_t queue_index) {
+    worker_pool = this;
+    worker_queue = queue_index;
+    std::function<void()> task;
+    while (true) {
+        if (this->takeTask(queue_index, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> sleep_guard(this->sleep_lock);
+        this->wake_condition.wait(sleep_guard, [this]() { return this->is_stopping || this->pending_count > 0; });
+        if (this->is_stopping && this->pending_count == 0) return;
+    }
+}
+
+
+void ThreadPool::parallelFor(size_t begin, size_t end, size_t chunk_size,
+                             const std::function<void(size_t, size_t)>& body) {
+    if (begin >= end) return;
+    chunk_size = std::max<size_t>(chunk_size, 1);
+    TaskGroup group(*this);
+    // the calling thread takes the first chunk itself, instead of waiting for a worker to take it
+    for (size_t chunk_begin = begin + chunk_size; chunk_begin < end; chunk_begin += chunk_size) {
+        group.run([&body, chunk_begin, chunk_end = std::min(chunk_begin + chunk_size, end)]() {
+            body(chunk_begin, chunk_end);
+        });
+    }
+    body(begin, std::min(begin + chunk_size, end));
+    group.wait();
+}
+
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> sleep_guard(this->sleep_lock);
+        this->is_stopping = true;
+    }
+    this->wake_condition.notify_all();
+    for (std::thread& worker : this->workers) worker.join();
+}
+
+
+TaskGroup::TaskGroup(ThreadPool& pool): pool(pool) {
+}
+
+
+void TaskGroup::run(std::function<void()> task) {
+    this->unfinished_count++;
+    this->pool.submit([this, task = std::move(task)]() {
+        // the task is done once its exception is kept, so a throwing task doesn't leave wait spinning
+        struct FinishGuard {
+            std::atomic<size_t>& unfinished_count;
+            ~FinishGuard() { this->unfinished_count--; }
+        } finish_guard{this->unfinished_count};
+        try {
+            task();
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> exception_guard(this->exception_lock);
+            if (!this->first_exception) this->first_exception = std::current_exception();
+        }
+    });
+}
+
+
+void TaskGroup::waitForTasks() {
+    while (this->unfinished_count > 0) {
+        // the last tasks of the group may be running on other threads, with nothing left to take meanwhile
+        if (!this->pool.runPendingTask()) std::this_thread::yield();
+    }
+}
+
+
+void TaskGroup::wait() {
+    this->waitForTasks();
+    std::exception_ptr exception;
+    {
+        std::lock_guard<std::mutex> exception_guard(this->exception_lock);
+        exception = std::exchange(this->first_exception, nullptr);
+    }
+    if (exception) std::rethrow_exception(exception);
+}
+
+
+TaskGroup::~TaskGroup() {
+    this->waitForTasks();
+}
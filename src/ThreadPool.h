@@ -0,0 +1,176 @@
+/**
+ * This code provides a work-stealing pool of worker threads that the parallel parts of the tool share, so that
+ * running several of them at once doesn't start more threads than there are cores.
+ *
+ * Every worker owns a deque of tasks. A worker pushes the tasks it submits to the back of its own deque and takes
+ * tasks from the back too, so it keeps working on what it just split off, and a worker whose deque is empty steals
+ * from the front of the others, where the oldest and usually biggest tasks are. Tasks submitted by threads outside
+ * of the pool go to one more deque that all the workers steal from.
+ *
+ * A TaskGroup waits for a set of tasks, and the waiting thread runs pending tasks of the pool meanwhile instead of
+ * blocking, so a task can split its work into a group of its own without running out of workers.
+ */
+
+#ifndef ALGOVIZ_THREADPOOL_H
+#define ALGOVIZ_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+class ThreadPool {
+    struct TaskQueue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<TaskQueue>> queues; // one per worker, then the one of the threads outside the pool
+    std::vector<std::thread> workers;
+    std::atomic<size_t> pending_count = 0; // the number of tasks in all the queues
+    std::mutex sleep_lock;
+    std::condition_variable wake_condition; // wakes the workers when tasks are submitted or the pool stops
+    bool is_stopping = false;
+
+
+    /** Returns the index of the calling thread's queue.
+     *
+     * @return The index of the worker's queue if called by a worker of this pool, or the index of the queue of the
+     * threads outside the pool otherwise.
+     */
+    size_t currentQueue() const;
+
+
+    /** Takes a task from the back of a queue, or steals one from the front of the other queues if it's empty.
+     *
+     * @param queue_index - the index of the queue to take from first
+     * @param task - set to the task that was taken
+     * @return true if a task was taken, false if all the queues are empty
+     */
+    bool takeTask(size_t queue_index, std::function<void()>& task);
+
+
+    /** The loop of every worker, which runs tasks until the pool stops and its queues are empty.
+     *
+     * @param queue_index - the index of the worker's queue
+     */
+    void workerLoop(size_t queue_index);
+
+public:
+
+    /** Starts a pool of worker threads.
+     *
+     * @param threads_count - the number of workers, or 0 to use one less than the number of hardware threads, as
+     * the thread that waits for the tasks runs them too
+     */
+    explicit ThreadPool(unsigned int threads_count = 0);
+
+
+    /** Returns the pool shared by the whole tool, which is started the first time it's asked for.
+     *
+     * @return The shared pool.
+     */
+    static ThreadPool& shared();
+
+
+    /** Returns the number of worker threads of the pool.
+     *
+     * @return The number of workers.
+     */
+    unsigned int getThreadsCount() const;
+
+
+    /** Queues a task to run on one of the workers. Use a TaskGroup to wait for it.
+     *
+     * @param task - the task to run
+     */
+    void submit(std::function<void()> task);
+
+
+    /** Runs one pending task of the pool on the calling thread, if there is any.
+     *
+     * @return true if a task was run, false if all the queues were empty
+     */
+    bool runPendingTask();
+
+
+    /** Splits a range of indices into chunks and runs a function on every chunk across the pool, returning once
+     * all of them are done.
+     *
+     * @param begin - the first index of the range
+     * @param end - one past the last index of the range
+     * @param chunk_size - the number of indices in every chunk but the last one
+     * @param body - called with the first index and one past the last index of every chunk
+     */
+    void parallelFor(size_t begin, size_t end, size_t chunk_size, const std::function<void(size_t, size_t)>& body);
+
+
+    /** Runs the tasks left in the queues, then stops the workers.
+     *
+     */
+    ~ThreadPool();
+
+
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+
+};
+
+
+class TaskGroup {
+    ThreadPool& pool;
+    std::atomic<size_t> unfinished_count = 0;
+    std::mutex exception_lock;
+    std::exception_ptr first_exception; // the first exception a task of the group threw, rethrown by wait
+
+
+    /** Waits until all the tasks of the group are done, running pending tasks of the pool meanwhile.
+     *
+     */
+    void waitForTasks();
+
+public:
+
+    /** Constructs an empty group of tasks.
+     *
+     * @param pool - the pool to run the tasks on
+     */
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::shared());
+
+
+    /** Queues a task of the group on the pool. A task that throws still counts as done, and the first exception
+     * thrown by the tasks of the group is kept for wait to rethrow.
+     *
+     * @param task - the task to run
+     */
+    void run(std::function<void()> task);
+
+
+    /** Waits until all the tasks of the group are done, running pending tasks of the pool meanwhile, then rethrows
+     * the first exception a task threw, if any did.
+     *
+     */
+    void wait();
+
+
+    /** Waits for the tasks of the group that aren't done yet. Exceptions the tasks threw that weren't rethrown by
+     * wait are dropped.
+     *
+     */
+    ~TaskGroup();
+
+
+    TaskGroup(const TaskGroup& other) = delete;
+    TaskGroup& operator=(const TaskGroup& other) = delete;
+
+};
+
+
+#endif //ALGOVIZ_THREADPOOL_H
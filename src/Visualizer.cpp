@@ -2,6 +2,7 @@
 #include "utils.h"
 #include "Node.h"
 #include "Interface.h"
+#include <atomic>
 #include <thread>
 #include <mutex>
 #include <iostream>
@@ -45,20 +46,19 @@ sf::Vector2i((float)sf::Mouse::getPosition(*this->window).x-(30*this->current_zo
 
 #define MAX_ZOOM    5
 #define MIN_ZOOM    0.2
+#define WINDOW_TITLE "Graph Visualizer"
 
 
 
 
 
-std::mutex window_lock; // prevents multiple threads from accessing window resource
-bool algo_thread_is_running = false; // true when a thread is currently running runBfs
-bool algo_thread_is_finished = false; // true when a thread ran and ended execution of runBfs, so we need to call join()
-bool algo_thread_should_end = false;
+std::recursive_mutex window_lock; // guards the window and the graph, which the algorithm task plays runs back on
+std::atomic<bool> playback_should_skip = false; // true when the running algorithm should jump to the end of its playback
+std::atomic<unsigned int> steps_per_second = DEFAULT_STEPS_PER_SECOND; // playback speed, 0 plays steps without waiting
+std::atomic<bool> playback_is_paused = false; // true when the running algorithm should hold on its current step
 
 bool is_immediate = false;
 
-std::thread algo_thread; // the thread we use to execute run<Algorithm> methods
-
 VisMode current_algo_mode;
 
 
@@ -67,8 +67,10 @@ Visualizer::Visualizer(const Graph& graph): graph(graph) {
     this->vis_font = new sf::Font();
     this->vis_font->loadFromFile("fonts/Raleway-Regular.ttf");
 
-    this->window = new sf::RenderWindow(sf::VideoMode(1400, 1000), "Graph Visualizer");
-    this->window->setFramerateLimit(120);
+    this->window = new sf::RenderWindow(sf::VideoMode(1400, 1000), WINDOW_TITLE);
+    this->window->setFramerateLimit(PLAYBACK_FPS);
+    // the title shows the options from the start, not only once one of them changes
+    this->updateTitle();
 
     this->current_view = this->window->getView();
     this->original_view = this->window->getDefaultView();
@@ -83,6 +85,7 @@ Visualizer::Visualizer(const Graph& graph): graph(graph) {
 
 
 Visualizer::~Visualizer() {
+  this->algorithm_task.cancel();
   delete this->window;
   delete this->vis_font;
   delete this->grid_bounds;
@@ -90,20 +93,12 @@ Visualizer::~Visualizer() {
 
 
 void Visualizer::run() {
+    this->graph_guard = std::unique_lock<std::recursive_mutex>(window_lock);
     this->render();
-    while(this->window->waitEvent(this->sfEvent)) {
-        if (algo_thread_is_finished) {
-            algo_thread.join();
-            algo_thread_is_finished = false;
-        }
-
+    while(this->waitEvent()) {
         switch (this->sfEvent.type) {
             case sf::Event::Closed: {
-                if (algo_thread_is_running || algo_thread_is_finished) {
-                    algo_thread_should_end = true;
-                    algo_thread.join();
-                    algo_thread_is_finished = false;
-                }
+                this->waitForAlgorithm(true);
                 this->window->close();
                 break;
             }
@@ -120,6 +115,13 @@ void Visualizer::run() {
                 this->window->setView(this->current_view);
                 break;
             }
+            case sf::Event::KeyPressed: {
+                pauseRoutine();
+                speedRoutine();
+                optionsRoutine();
+                seekRoutine();
+                break;
+            }
             case sf::Event::MouseWheelScrolled: {
                 if (this->sfEvent.mouseWheelScroll.delta > 0 && current_zoom_factor < MAX_ZOOM) {
                     this->current_view.zoom(0.875);
@@ -129,30 +131,29 @@ void Visualizer::run() {
                     this->current_view.zoom(1.142857);
                     this->current_zoom_factor *= 0.875;
                 }
-                if (!algo_thread_is_running) {
-                    this->render();
-                }
+                this->render();
                 break;
             }
             default: {
                 break;
             }
         }
-        if (!algo_thread_is_running) {
-            this->render();
-        }
+        this->render();
     }
+    this->graph_guard.unlock();
 }
 
 
 void Visualizer::render(bool load_list) {
     window_lock.lock();
+    // frames rendered while an algorithm plays look like the ones its playback renders
+    bool is_mid_run = this->algorithm_task.isRunning();
     window->setActive(true);
     this->window->clear(BG_COLOR);
-    drawGrid((*this->window), this->original_view, *this->grid_bounds);
+    if (!is_mid_run) drawGrid((*this->window), this->original_view, *this->grid_bounds);
     this->graph.render(*this->window, this->vis_font);
     this->window->setView(this->original_view);
-    this->toolbar.render(*this->window, false);
+    this->toolbar.render(*this->window, is_mid_run);
     if (load_list) this->saved_graphs_list.render(*(this->window));
     if (this->toolbar.getActiveButtonId() == ADD_NODE) {
         float corrected_radius = this->current_zoom_factor * NODE_RADIUS;
@@ -163,7 +164,7 @@ void Visualizer::render(bool load_list) {
     }
     this->window->setView(this->current_view);
     if (this->toolbar.getActiveButtonId() == ADD_EDGE && this->node_is_clicked) {
-        std::shared_ptr<Node> tmp_node = std::make_shared<Node>(Node("tmp", CORRECTED_MOUSE_X, CORRECTED_MOUSE_Y, vis_font));
+        std::shared_ptr<Node> tmp_node = std::make_shared<Node>("tmp", CORRECTED_MOUSE_X, CORRECTED_MOUSE_Y);
         std::shared_ptr<Edge> tmp_edge = std::make_shared<Edge>(Edge(this->clicked_node, tmp_node, false));
         tmp_edge->render(*this->window);
     }
@@ -203,6 +204,11 @@ void Visualizer::executeClickAction() {
             runAlgorithm();
             break;
         }
+        case RUN_ASTAR: {
+            current_algo_mode = ASTAR;
+            runAlgorithm();
+            break;
+        }
         case END: {
             endRoutine();
             break;
@@ -229,8 +235,8 @@ void Visualizer::executeClickAction() {
 
     }
 
-    if (is_immediate || algo_thread_is_running) return;
-    // the following cases are not allowed while an algorithm is running
+    if (is_immediate) return;
+    // the following cases edit the graph, which a running algorithm doesn't see, as it runs on a snapshot of it
     std::shared_ptr<Node> to_toggle = this->graph.getNodeByPosition(EVENT_X, EVENT_Y);
     this->graph.setToggledNode(to_toggle);
     switch (id) {
@@ -269,7 +275,7 @@ void Visualizer::executeClickAction() {
 
 
 void Visualizer::runAlgorithm() {
-    if (!this->graph.getStartNode() || algo_thread_is_running) {
+    if (!this->graph.getStartNode() || this->algorithm_task.isRunning()) {
         this->toolbar.resetActiveButton();
         return;
     }
@@ -277,7 +283,7 @@ void Visualizer::runAlgorithm() {
     auto window_y = (float) this->sfEvent.mouseButton.y;
     sf::Vector2f original_active_button_coordinates = sf::Vector2f(window_x, window_y);
     while (this->sfEvent.type != sf::Event::MouseButtonReleased) {
-        this->window->waitEvent(this->sfEvent);
+        this->waitEvent();
     }
     if (!this->toolbar.updateActiveButton(sf::Vector2f(window_x, window_y))) {
         this->toolbar.updateActiveButton(original_active_button_coordinates);
@@ -285,32 +291,34 @@ void Visualizer::runAlgorithm() {
     }
     this->graph.reset();
     this->toolbar.resetActiveButton();
+    playback_is_paused = false;
 
     VisMode current_mode = current_algo_mode;
-    bool should_wait = true;
-    switch (current_mode) {
-        case BFS: {
-            this->window->setActive(false);
-            algo_thread = std::thread(&Graph::runBFS, std::ref(this->graph), std::ref(*this->window),
-                                      std::ref(this->toolbar), std::ref(this->original_view),
-                                      std::ref(this->current_view), std::ref(this->vis_font), std::ref(*this->grid_bounds), should_wait);
-            break;
-        }
-        case DFS: {
-            this->window->setActive(false);
-            algo_thread = std::thread(&Graph::runDFS, std::ref(this->graph), std::ref(*this->window),
-                                      std::ref(this->toolbar), std::ref(this->original_view),
-                                      std::ref(this->current_view), std::ref(this->vis_font), std::ref(*this->grid_bounds), should_wait);
-            break;
-        }
-        case DIJKSTRA: {
-            this->window->setActive(false);
-            algo_thread = std::thread(&Graph::runDijkstra, std::ref(this->graph), std::ref(*this->window),
-                                      std::ref(this->toolbar), std::ref(this->original_view),
-                                      std::ref(this->current_view), std::ref(this->vis_font), std::ref(*this->grid_bounds), should_wait);
-            break;
+    this->window->setActive(false);
+    this->algorithm_task = this->scheduler.submit([this, current_mode](std::stop_token stop_token) {
+        switch (current_mode) {
+            case BFS: {
+                this->graph.runBFS(*this->window, this->toolbar, this->original_view, this->current_view,
+                                   this->vis_font, *this->grid_bounds, true, stop_token);
+                break;
+            }
+            case DFS: {
+                this->graph.runDFS(*this->window, this->toolbar, this->original_view, this->current_view,
+                                   this->vis_font, *this->grid_bounds, true, stop_token);
+                break;
+            }
+            case DIJKSTRA: {
+                this->graph.runDijkstra(*this->window, this->toolbar, this->original_view, this->current_view,
+                                        this->vis_font, *this->grid_bounds, true, stop_token);
+                break;
+            }
+            case ASTAR: {
+                this->graph.runAStar(*this->window, this->toolbar, this->original_view, this->current_view,
+                                     this->vis_font, *this->grid_bounds, true, stop_token);
+                break;
+            }
         }
-    }
+    });
 }
 
 
@@ -335,7 +343,7 @@ void Visualizer::cursorRoutine() {
             }
             prev_pos = current_pos;
             this->render();
-            this->window->waitEvent(this->sfEvent);
+            this->waitEvent();
         }
         return;
     }
@@ -355,22 +363,30 @@ void Visualizer::cursorRoutine() {
                 if (!this->graph.checkValidPosition(*moving_node)) continue;
             }
         }
-        if (current_algo_mode == DIJKSTRA && (this->graph.getStartNode()->getState() == NODE_DONE ||
-                                              this->graph.getStartNode()->getState() == NODE_NEAREST)) {
-            this->graph.runDijkstra(*(this->window), this->toolbar, this->original_view,
-                                    this->current_view, this->vis_font, *grid_bounds, false);
+        // the last run is rerun for the new edge lengths, unless it's still playing
+        if (!this->algorithm_task.isRunning() && (current_algo_mode == DIJKSTRA || current_algo_mode == ASTAR) &&
+            (this->graph.getStartNode()->getState() == NODE_DONE ||
+             this->graph.getStartNode()->getState() == NODE_NEAREST)) {
+            if (current_algo_mode == DIJKSTRA) {
+                this->graph.runDijkstra(*(this->window), this->toolbar, this->original_view,
+                                        this->current_view, this->vis_font, *grid_bounds, false);
+            }
+            else {
+                this->graph.runAStar(*(this->window), this->toolbar, this->original_view,
+                                     this->current_view, this->vis_font, *grid_bounds, false);
+            }
             this->graph.setToggledNode(moving_node);
         }
         this->render();
-        this->window->pollEvent(this->sfEvent);
+        this->pollEvent();
     }
 }
 
 
 void Visualizer::addNodeRoutine() {
-    std::shared_ptr<Node> node_exists = this->graph.addNode(CORRECTED_EVENT_X, CORRECTED_EVENT_Y, this->vis_font);
+    std::shared_ptr<Node> node_exists = this->graph.addNode(CORRECTED_EVENT_X, CORRECTED_EVENT_Y);
     if (node_exists) {
-        this->graph.reset();
+        this->resetEditedGraph();
     }
 }
 
@@ -391,7 +407,7 @@ void Visualizer::addEdgeRoutine() {
         this->node_is_clicked = false;
         this->clicked_node = nullptr;
         if (edge_was_added) {
-            this->graph.reset();
+            this->resetEditedGraph();
         }
         return;
     }
@@ -408,13 +424,13 @@ void Visualizer::addEdgeRoutine() {
             // Keep rendering an edge animation that follows the mouse from the clicked node:
             this->render();
             dst = this->graph.getNodeByPosition(MOUSE_X, MOUSE_Y);
-            this->window->waitEvent(this->sfEvent);
+            this->waitEvent();
             if (this->sfEvent.type == sf::Event::MouseButtonReleased) {
                 if (dst == clicked_node) {
                     if (edge_was_added) {
                         this->clicked_node = nullptr;
                         this->node_is_clicked = false;
-                        this->graph.reset();
+                        this->resetEditedGraph();
                     }
                     return;
                 }
@@ -440,10 +456,10 @@ void Visualizer::addEdgeRoutine() {
             this->render();
             edge_was_added = true;
         }
-        this->window->waitEvent(this->sfEvent);
+        this->waitEvent();
     }
     if (edge_was_added) {
-        this->graph.reset();
+        this->resetEditedGraph();
     }
 }
 
@@ -454,13 +470,13 @@ void Visualizer::eraseRoutine() {
     std::shared_ptr<Node> node_to_delete = this->graph.getNodeByPosition(EVENT_X, EVENT_Y);
     std::shared_ptr<Edge> edge_to_delete = this->graph.getEdgeByPosition(EVENT_X, EVENT_Y);
     if (node_to_delete) {
-        this->graph.removeNode(node_to_delete->getName());
+        this->graph.removeNode(node_to_delete->getId());
     }
     else if (edge_to_delete) {
         this->graph.removeEdge(edge_to_delete);
     }
     if (node_to_delete || edge_to_delete) {
-        this->graph.reset();
+        this->resetEditedGraph();
     }
 }
 
@@ -468,7 +484,7 @@ void Visualizer::eraseRoutine() {
 void Visualizer::changeStartNodeRoutine() {
     std::shared_ptr<Node> node_exists = this->graph.getNodeByPosition(EVENT_X, EVENT_Y);
     if (node_exists) {
-        this->graph.reset();
+        this->resetEditedGraph();
     }
     this->graph.setStartNode(this->graph.getNodeByPosition(EVENT_X, EVENT_Y));
 }
@@ -476,14 +492,14 @@ void Visualizer::changeStartNodeRoutine() {
 void Visualizer::chooseTargetNodeRoutine() {
     std::shared_ptr<Node> node_exists = this->graph.getNodeByPosition(EVENT_X, EVENT_Y);
     if (node_exists) {
-        this->graph.reset();
+        this->resetEditedGraph();
     }
     this->graph.setTargetNode(this->graph.getNodeByPosition(EVENT_X, EVENT_Y));
 }
 
 void Visualizer::removeTargetNodeRoutine() {
-    if (algo_thread_is_running || !is_immediate) return;
-    this->graph.reset();
+    if (!is_immediate) return;
+    this->resetEditedGraph();
     this->graph.removeTargetNode();
     this->toolbar.resetActiveButton();
 }
@@ -491,49 +507,147 @@ void Visualizer::removeTargetNodeRoutine() {
 
 void Visualizer::endRoutine() {
     this->toolbar.resetActiveButton();
-    if (!algo_thread_is_running) return;
-    algo_thread_should_end = true;
-    algo_thread.join();
-    algo_thread_is_finished = false;
-    algo_thread_should_end = false;
+    if (!this->algorithm_task.isRunning()) return;
+    playback_should_skip = true;
+    this->waitForAlgorithm(false);
+    playback_should_skip = false;
+    this->toolbar.resetActiveButton();
+}
 
-    this->graph.reset();
-    if (current_algo_mode == BFS) {
-        this->graph.runBFS(*this->window, this->toolbar, this->original_view,
-                           this->current_view, this->vis_font, *grid_bounds, false);
+
+void Visualizer::pauseRoutine() {
+    if (this->sfEvent.key.code != sf::Keyboard::Space) return;
+    playback_is_paused = !playback_is_paused;
+}
+
+
+void Visualizer::speedRoutine() {
+    unsigned int speed = steps_per_second;
+    if (this->sfEvent.key.code == sf::Keyboard::Up) {
+        if (speed != 0) speed = (speed < MAX_STEPS_PER_SECOND) ? speed * 2 : 0;
     }
-    else if (current_algo_mode == DFS) {
-        this->graph.runDFS(*this->window, this->toolbar, this->original_view,
-                           this->current_view, this->vis_font, *grid_bounds, false);
+    else if (this->sfEvent.key.code == sf::Keyboard::Down) {
+        if (speed == 0) speed = MAX_STEPS_PER_SECOND;
+        else if (speed > 1) speed /= 2;
     }
-    else {
-        this->graph.runDijkstra(*this->window, this->toolbar, this->original_view,
-                                this->current_view, this->vis_font, *grid_bounds, false);
+    else return;
+    steps_per_second = speed;
+    this->updateTitle();
+}
+
+
+void Visualizer::optionsRoutine() {
+    if (this->algorithm_task.isRunning()) return;
+    if (this->sfEvent.key.code == sf::Keyboard::Q) {
+        switch (this->graph.getDijkstraQueue()) {
+            case QUEUE_AUTOMATIC: {
+                this->graph.setDijkstraQueue(QUEUE_DARY_HEAP);
+                break;
+            }
+            case QUEUE_DARY_HEAP: {
+                this->graph.setDijkstraQueue(QUEUE_PAIRING_HEAP);
+                break;
+            }
+            case QUEUE_PAIRING_HEAP: {
+                this->graph.setDijkstraQueue(QUEUE_BUCKETS);
+                break;
+            }
+            default: {
+                this->graph.setDijkstraQueue(QUEUE_AUTOMATIC);
+                break;
+            }
+        }
     }
-    this->toolbar.resetActiveButton();
+    else if (this->sfEvent.key.code == sf::Keyboard::B) {
+        this->graph.setBidirectionalSearch(!this->graph.isBidirectionalSearch());
+    }
+    else if (this->sfEvent.key.code == sf::Keyboard::H) {
+        if (!this->graph.isHeadlessSearch()) this->graph.setHeadlessSearch(true, 0);
+        else if (this->graph.getSearchThreads() != 1) this->graph.setHeadlessSearch(true, 1);
+        else this->graph.setHeadlessSearch(false);
+    }
+    else return;
+    this->updateTitle();
 }
 
 
-void Visualizer::resetRoutine() {
-    if (algo_thread_is_running) {
-        algo_thread_should_end = true;
-        algo_thread.join();
-        algo_thread_is_finished = false;
-        algo_thread_should_end = false;
+void Visualizer::updateTitle() {
+    unsigned int speed = steps_per_second;
+    std::string speed_name = (speed == 0) ? "unlimited" : std::to_string(speed);
+    std::string queue_name;
+    switch (this->graph.getDijkstraQueue()) {
+        case QUEUE_DARY_HEAP: {
+            queue_name = "d-ary heap";
+            break;
+        }
+        case QUEUE_PAIRING_HEAP: {
+            queue_name = "pairing heap";
+            break;
+        }
+        case QUEUE_BUCKETS: {
+            queue_name = "bucket queue";
+            break;
+        }
+        default: {
+            queue_name = "automatic queue";
+            break;
+        }
     }
+    std::string search_name = this->graph.isBidirectionalSearch() ? "bidirectional" : "one-sided";
+    std::string mode_name = "animated";
+    if (this->graph.isHeadlessSearch())
+        mode_name = (this->graph.getSearchThreads() == 1) ? "headless on 1 thread" : "headless on all cores";
+    this->window->setTitle(std::string(WINDOW_TITLE) + " - " + speed_name + " steps/s - " + queue_name + " - " +
+                           search_name + " - " + mode_name);
+}
+
+
+void Visualizer::seekRoutine() {
+    if (this->algorithm_task.isRunning()) return;
+    size_t step = this->graph.getRecordingStep();
+    switch (this->sfEvent.key.code) {
+        case sf::Keyboard::Left: {
+            if (step > 0) step--;
+            break;
+        }
+        case sf::Keyboard::Right: {
+            step++;
+            break;
+        }
+        case sf::Keyboard::Home: {
+            step = 0;
+            break;
+        }
+        case sf::Keyboard::End: {
+            step = this->graph.getRecordingLength();
+            break;
+        }
+        default: {
+            return;
+        }
+    }
+    if (this->graph.seekRecording(step)) this->render();
+}
+
+
+void Visualizer::resetRoutine() {
+    this->waitForAlgorithm(true);
     this->graph.reset();
     this->toolbar.resetActiveButton();
 }
 
 
 void Visualizer::clearWindowRoutine() {
-    if (algo_thread_is_running) {
-        algo_thread_should_end = true;
-        algo_thread.join();
-        algo_thread_is_finished = false;
-        algo_thread_should_end = false;
-    }
+    this->waitForAlgorithm(true);
+    // the search options belong to the user rather than to the graph, so they carry over to the new one
+    PriorityQueueType queue_type = this->graph.getDijkstraQueue();
+    bool is_bidirectional = this->graph.isBidirectionalSearch();
+    bool is_headless = this->graph.isHeadlessSearch();
+    unsigned int threads_count = this->graph.getSearchThreads();
     this->graph = Graph();
+    this->graph.setDijkstraQueue(queue_type);
+    this->graph.setBidirectionalSearch(is_bidirectional);
+    this->graph.setHeadlessSearch(is_headless, threads_count);
     this->node_is_clicked = false;
     this->clicked_node = nullptr;
     this->toolbar.resetActiveButton();
@@ -543,7 +657,7 @@ void Visualizer::clearWindowRoutine() {
 
 void Visualizer::saveToFile() {
     std::string graph_name;
-    this->window->waitEvent(this->sfEvent);
+    this->waitEvent();
     InputBox inputBox(*(this->window), this->vis_font);
     this->window->setView(this->original_view);
     graph_name = inputBox.getInput(*(this->window));
@@ -573,8 +687,8 @@ void Visualizer::loadFromFile() {
     save_file.clear();
     save_file.seekg(0);
 
-    if (!algo_thread_is_running) this->render(load_list);
-    while (this->window->waitEvent(this->sfEvent)) {
+    this->render(load_list);
+    while (this->waitEvent()) {
         if (this->sfEvent.type == sf::Event::MouseButtonPressed) {
             graph_name = this->saved_graphs_list.getClickedGraph(EVENT_X, EVENT_Y);
             break;
@@ -598,7 +712,7 @@ void Visualizer::loadFromFile() {
     }
     save_file.close();
 
-    std::vector<std::shared_ptr<Node>> nodes = parseNodesFromString(graph_literal, this->vis_font);
+    std::vector<std::shared_ptr<Node>> nodes = parseNodesFromString(graph_literal);
     std::vector<std::shared_ptr<Edge>> edges = parseEdgesFromString(graph_literal, nodes);
     this->clearWindowRoutine();
     for (auto& node : nodes) {
@@ -614,6 +728,38 @@ void Visualizer::loadFromFile() {
 
 //**********************************************Auxiliary Functions***************************************************//
 
+bool Visualizer::waitEvent() {
+    // the algorithm task can only apply its steps while the event loop doesn't hold the graph
+    this->graph_guard.unlock();
+    bool is_open = this->window->waitEvent(this->sfEvent);
+    this->graph_guard.lock();
+    return is_open;
+}
+
+
+bool Visualizer::pollEvent() {
+    this->graph_guard.unlock();
+    bool has_event = this->window->pollEvent(this->sfEvent);
+    this->graph_guard.lock();
+    return has_event;
+}
+
+
+void Visualizer::waitForAlgorithm(bool cancel) {
+    // the task may be waiting for the graph to apply its next frame, so it's released until the task is done
+    this->graph_guard.unlock();
+    if (cancel) this->algorithm_task.cancel();
+    else this->algorithm_task.wait();
+    this->graph_guard.lock();
+}
+
+
+void Visualizer::resetEditedGraph() {
+    // a running algorithm keeps playing its run on the nodes it started with, until it's done
+    if (!this->algorithm_task.isRunning()) this->graph.reset();
+}
+
+
 bool Visualizer::viewIsInBounds() {
     sf::Vector2f viewCenter = this->current_view.getCenter();
     float viewWidth = this->current_view.getSize().x;
@@ -632,7 +778,7 @@ bool Visualizer::viewIsInBounds() {
 
 
 
-std::vector<std::shared_ptr<Node>> Visualizer::parseNodesFromString(const std::string& graph_literal, sf::Font* font) {
+std::vector<std::shared_ptr<Node>> Visualizer::parseNodesFromString(const std::string& graph_literal) {
     std::string tmp_literal = graph_literal;
 
     std::vector<std::shared_ptr<Node>> nodes;
@@ -673,7 +819,7 @@ std::vector<std::shared_ptr<Node>> Visualizer::parseNodesFromString(const std::s
         float pos_y = (float)std::stoi(y_str.substr(std::min(0, (int)pos_str.find('-')+1)));
         if (x_str[0] == '-') pos_x = -pos_x;
         if (y_str[0] == '-') pos_y = -pos_y;
-        std::shared_ptr<Node> to_add = std::make_shared<Node>(Node(node_names[i], pos_x, pos_y, font));
+        std::shared_ptr<Node> to_add = std::make_shared<Node>(node_names[i], pos_x, pos_y);
         if (to_add->getName() == start_node_name) to_add->setState(NODE_START);
         nodes.push_back(to_add);
     }
@@ -2,11 +2,14 @@
 #define ALGOVIZ_VISUALIZER_H
 #include "Graph.h"
 #include "Interface.h"
+#include "TaskScheduler.h"
+#include <mutex>
 
 enum VisMode {
     BFS,
     DFS,
-    DIJKSTRA
+    DIJKSTRA,
+    ASTAR
 };
 
 
@@ -49,13 +52,16 @@ private:
     bool node_is_clicked = false;
     float current_zoom_factor = 1.f;
     sf::FloatRect* grid_bounds;
+    TaskScheduler scheduler; // runs the jobs that shouldn't block the event loop
+    TaskHandle algorithm_task; // the last algorithm run submitted to the scheduler
+    std::unique_lock<std::recursive_mutex> graph_guard; // held by the event loop, except while it waits
 
 
     /** Parses the graph_literal parameter and creates Node objects for each node in the graph.
      *
      * Returns a vector of shared pointers to the created Node objects.
      */
-    static std::vector<std::shared_ptr<Node>> parseNodesFromString(const std::string& graph_literal, sf::Font* font);
+    static std::vector<std::shared_ptr<Node>> parseNodesFromString(const std::string& graph_literal);
 
 
     /** Parses the graph_literal parameter and creates Edge objects for each edge in the graph.
@@ -65,6 +71,35 @@ private:
     static std::vector<std::shared_ptr<Edge>> parseEdgesFromString(const std::string& graph_literal,
                                                                    std::vector<std::shared_ptr<Node>>& nodes);
 
+    /** Waits for the next event of the window, letting a running algorithm apply its steps to the graph meanwhile.
+     *
+     * @return false if the window was closed, true otherwise
+     */
+    bool waitEvent();
+
+
+    /** Takes the next event of the window if there is one, letting a running algorithm apply its steps to the graph
+     * meanwhile.
+     *
+     * @return true if an event was taken, false otherwise
+     */
+    bool pollEvent();
+
+
+    /** Waits until the running algorithm is done, if there is one, letting it apply its steps to the graph meanwhile.
+     *
+     * @param cancel - true to cancel the run, false to wait for it to end
+     */
+    void waitForAlgorithm(bool cancel);
+
+
+    /** Clears the results of the last run after the graph was edited. A running algorithm runs on a snapshot of
+     * the graph, so its run keeps playing until it's done instead.
+     *
+     */
+    void resetEditedGraph();
+
+
     /** Checks whether the current view is within the bounds of the visualization window.
      *
      * @return True if the current view is within the bounds of the visualization window, false otherwise.
@@ -85,7 +120,7 @@ private:
     void executeClickAction();
 
 
-    /** Runs the algorithm on the graph. This function applies the selected algorithm (BFS/DFS/DIJKSTRA) on the graph
+    /** Runs the algorithm on the graph. This function applies the selected algorithm (BFS/DFS/DIJKSTRA/ASTAR) on the graph
      * and updates the visualization accordingly.
      * If no algorithm is selected, it does nothing.
      */
@@ -124,7 +159,7 @@ private:
     void changeStartNodeRoutine();
 
 
-    /** Ends the running algorithm, completing it without waiting after each step of the algorithm.
+    /** Ends the running algorithm, jumping to the end of its playback without waiting after each step.
      *
      * It is useful for stopping a long-running algorithm prematurely.
      *
@@ -132,6 +167,41 @@ private:
     void endRoutine();
 
 
+    /** Pauses or resumes the playback of the running algorithm with the space key.
+     *
+     */
+    void pauseRoutine();
+
+
+    /** Doubles the playback speed with the up arrow key or halves it with the down arrow key, and shows it in the
+     * window's title. Above MAX_STEPS_PER_SECOND, steps are shown as fast as they're recorded.
+     *
+     */
+    void speedRoutine();
+
+
+    /** Cycles the priority queue of Dijkstra's algorithm and A* with the Q key, switches between searching from
+     * both ends and from the start node only with the B key, and cycles BFS and Dijkstra with no target node between
+     * playing the search back, running it headless on every core and running it headless on one thread with the H
+     * key, and shows them in the window's title. The options can't change while an algorithm is running, and apply
+     * from the next run.
+     *
+     */
+    void optionsRoutine();
+
+
+    /** Shows the playback speed and the search options in the window's title.
+     *
+     */
+    void updateTitle();
+
+
+    /** Moves through the steps of the last run with the arrow keys, or jumps to its start or end with Home and End.
+     *
+     */
+    void seekRoutine();
+
+
     /** Resets the current graph, clearing all algorithm-related changes, and stopping any running algorithm.
      *
      */